@@ -0,0 +1,185 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <tbs/memory/Arena.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace tbs::memory
+{
+    /**
+     * 块头部，数据区紧随其后并按 max_align_t 对齐。
+     */
+    struct alignas(std::max_align_t) Arena::Chunk
+    {
+        Chunk* next = nullptr;
+        size_t capacity = 0;
+        std::atomic<size_t> used{0};
+
+        std::byte* data()
+        {
+            return reinterpret_cast<std::byte*>(this + 1);
+        }
+    };
+
+    static size_t alignUp(std::uintptr_t p, size_t alignment)
+    {
+        return (p + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    }
+
+    Arena::Arena(size_t chunkSize, std::pmr::memory_resource* upstream) : m_chunkSize(std::max<size_t>(chunkSize, 256)), m_upstream(upstream)
+    {
+        if (m_upstream == nullptr)
+        {
+            throw tbs::base_error("Arena: upstream memory resource can not be null");
+        }
+    }
+
+    Arena::~Arena()
+    {
+        release();
+    }
+
+    Arena::Chunk* Arena::newChunk(size_t capacity)
+    {
+        void* p = m_upstream->allocate(sizeof(Chunk) + capacity, alignof(Chunk));
+        auto* c = ::new (p) Chunk();
+        c->capacity = capacity;
+        return c;
+    }
+
+    void Arena::freeChunks(Chunk*& head)
+    {
+        while (head != nullptr)
+        {
+            Chunk* n = head->next;
+            size_t total = sizeof(Chunk) + head->capacity;
+            head->~Chunk();
+            m_upstream->deallocate(head, total, alignof(Chunk));
+            head = n;
+        }
+    }
+
+    void* Arena::do_allocate(size_t bytes, size_t alignment)
+    {
+        // 大块单独申请，挂到链表上但不替换当前块，避免浪费当前块剩余空间
+        if (bytes + alignment > m_chunkSize / 2)
+        {
+            std::lock_guard<std::mutex> g(m_mutex);
+            Chunk* c = newChunk(bytes + alignment);
+            auto base = reinterpret_cast<std::uintptr_t>(c->data());
+            size_t offset = alignUp(base, alignment) - base;
+            c->used.store(offset + bytes, std::memory_order_relaxed);
+            c->next = m_chunks;
+            m_chunks = c;
+            return c->data() + offset;
+        }
+        while (true)
+        {
+            Chunk* c = m_current.load(std::memory_order_acquire);
+            if (c != nullptr)
+            {
+                auto base = reinterpret_cast<std::uintptr_t>(c->data());
+                size_t used = c->used.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    size_t offset = alignUp(base + used, alignment) - base;
+                    if (offset + bytes > c->capacity)
+                    {
+                        break;
+                    }
+                    if (c->used.compare_exchange_weak(used, offset + bytes, std::memory_order_relaxed))
+                    {
+                        return c->data() + offset;
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> g(m_mutex);
+            if (m_current.load(std::memory_order_relaxed) != c)
+            {
+                // 其他线程已经换过块，重新尝试
+                continue;
+            }
+            Chunk* n = m_spare;
+            if (n != nullptr)
+            {
+                m_spare = n->next;
+            }
+            else
+            {
+                n = newChunk(m_chunkSize);
+            }
+            n->next = m_chunks;
+            m_chunks = n;
+            m_current.store(n, std::memory_order_release);
+        }
+    }
+
+    void Arena::do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/)
+    {
+    }
+
+    bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    void Arena::reset()
+    {
+        std::lock_guard<std::mutex> g(m_mutex);
+        Chunk* large = nullptr;
+        while (m_chunks != nullptr)
+        {
+            Chunk* c = m_chunks;
+            m_chunks = c->next;
+            if (c->capacity == m_chunkSize)
+            {
+                c->used.store(0, std::memory_order_relaxed);
+                c->next = m_spare;
+                m_spare = c;
+            }
+            else
+            {
+                c->next = large;
+                large = c;
+            }
+        }
+        freeChunks(large);
+        m_current.store(nullptr, std::memory_order_release);
+    }
+
+    void Arena::release()
+    {
+        std::lock_guard<std::mutex> g(m_mutex);
+        freeChunks(m_chunks);
+        freeChunks(m_spare);
+        m_current.store(nullptr, std::memory_order_release);
+    }
+
+    size_t Arena::usedBytes() const
+    {
+        std::lock_guard<std::mutex> g(m_mutex);
+        size_t r = 0;
+        for (Chunk* c = m_chunks; c != nullptr; c = c->next)
+        {
+            r += std::min(c->used.load(std::memory_order_relaxed), c->capacity);
+        }
+        return r;
+    }
+
+    size_t Arena::capacity() const
+    {
+        std::lock_guard<std::mutex> g(m_mutex);
+        size_t r = 0;
+        for (Chunk* c = m_chunks; c != nullptr; c = c->next)
+        {
+            r += c->capacity;
+        }
+        for (Chunk* c = m_spare; c != nullptr; c = c->next)
+        {
+            r += c->capacity;
+        }
+        return r;
+    }
+} // namespace tbs::memory
@@ -0,0 +1,59 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <tbs/strings/Numeric.h>
+
+#include <bit>
+#include <cstring>
+
+namespace
+{
+    /**
+     * 8 个字节是否全是 '0' ~ '9'：高半字节必须是 3，且低半字节加 6 后不进位。
+     */
+    inline bool allDigits8(uint64_t v)
+    {
+        return ((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+    }
+
+    /**
+     * 把小端序读入的 8 个 ASCII 数字转成数值：相邻两位、四位、八位依次合并，共三次乘法。
+     */
+    inline uint32_t parse8Digits(uint64_t v)
+    {
+        v -= 0x3030303030303030ULL;
+        v = (v * 10) + (v >> 8);
+        v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        return static_cast<uint32_t>(v);
+    }
+} // namespace
+
+bool parseDecimalDigits(CONST char* str, size_t len, uint64_t& out)
+{
+    uint64_t acc = 0;
+    size_t i = 0;
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        for (; i + 8 <= len; i += 8)
+        {
+            uint64_t chunk;
+            std::memcpy(&chunk, str + i, 8);
+            if (!allDigits8(chunk))
+            {
+                return false;
+            }
+            acc = acc * 100000000ULL + parse8Digits(chunk);
+        }
+    }
+    for (; i < len; i++)
+    {
+        auto d = static_cast<unsigned char>(str[i] - '0');
+        if (d > 9)
+        {
+            return false;
+        }
+        acc = acc * 10 + d;
+    }
+    out = acc;
+    return true;
+}
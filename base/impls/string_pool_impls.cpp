@@ -0,0 +1,152 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <tbs/strings/StringPool.h>
+
+#include <bit>
+#include <cstring>
+
+namespace
+{
+    /**
+     * 条目序号到 (段号, 段内偏移) 的映射：第 k 段从 64 * (2^k - 1) 开始，容纳 64 * 2^k 个条目。
+     */
+    inline size_t segmentOf(uint32_t id)
+    {
+        return std::bit_width((static_cast<size_t>(id) >> 6) + 1) - 1;
+    }
+
+    inline size_t segmentBase(size_t segment)
+    {
+        return 64 * ((size_t{1} << segment) - 1);
+    }
+} // namespace
+
+StringPool::StringPool(size_t chunkSize) : m_arena(chunkSize), m_table(new Table(256))
+{
+    for (auto& s : m_segments)
+    {
+        s.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+StringPool::~StringPool()
+{
+    delete m_table.load(std::memory_order_relaxed);
+}
+
+CONST StringPool::Entry& StringPool::entryAt(uint32_t id) const
+{
+    size_t s = segmentOf(id);
+    return m_segments[s].load(std::memory_order_acquire)[id - segmentBase(s)];
+}
+
+uint32_t StringPool::probe(CONST Table& table, std::string_view str, size_t hash) const
+{
+    for (size_t i = hash & table.mask;; i = (i + 1) & table.mask)
+    {
+        uint32_t v = table.slots[i].load(std::memory_order_acquire);
+        if (v == 0)
+        {
+            return InternedString::INVALID_ID;
+        }
+        CONST Entry& e = entryAt(v - 1);
+        if (e.hash == hash && e.length == str.size() && std::memcmp(e.data, str.data(), str.size()) == 0)
+        {
+            return v - 1;
+        }
+    }
+}
+
+void StringPool::insertSlot(Table& table, uint32_t id, size_t hash)
+{
+    size_t i = hash & table.mask;
+    while (table.slots[i].load(std::memory_order_relaxed) != 0)
+    {
+        i = (i + 1) & table.mask;
+    }
+    table.slots[i].store(id + 1, std::memory_order_release);
+}
+
+Option<InternedString> StringPool::find(std::string_view str) const
+{
+    size_t hash = std::hash<std::string_view>{}(str);
+    uint32_t id = probe(*m_table.load(std::memory_order_acquire), str, hash);
+    return id == InternedString::INVALID_ID ? Option<InternedString>() : Option<InternedString>(InternedString(id));
+}
+
+InternedString StringPool::intern(std::string_view str)
+{
+    size_t hash = std::hash<std::string_view>{}(str);
+    uint32_t id = probe(*m_table.load(std::memory_order_acquire), str, hash);
+    if (id != InternedString::INVALID_ID)
+    {
+        return InternedString(id);
+    }
+
+    std::lock_guard<std::mutex> g(m_mutex);
+    Table* table = m_table.load(std::memory_order_relaxed);
+    // 加锁期间可能已有其他线程插入了同一个字符串
+    id = probe(*table, str, hash);
+    if (id != InternedString::INVALID_ID)
+    {
+        return InternedString(id);
+    }
+    id = m_count.load(std::memory_order_relaxed);
+    if (id == InternedString::INVALID_ID)
+    {
+        throw tbs::base_error("StringPool: too many interned strings");
+    }
+
+    // 先写入条目，再通过哈希表槽位发布句柄
+    size_t s = segmentOf(id);
+    Entry* segment = m_segments[s].load(std::memory_order_relaxed);
+    if (segment == nullptr)
+    {
+        size_t n = FIRST_SEGMENT_SIZE << s;
+        segment = static_cast<Entry*>(m_arena.allocate(n * sizeof(Entry), alignof(Entry)));
+        m_segments[s].store(segment, std::memory_order_release);
+    }
+    char* data = static_cast<char*>(m_arena.allocate(str.empty() ? 1 : str.size(), 1));
+    std::memcpy(data, str.data(), str.size());
+    segment[id - segmentBase(s)] = Entry{data, str.size(), hash};
+    m_count.store(id + 1, std::memory_order_release);
+
+    if ((static_cast<size_t>(id) + 1) * 2 > table->mask + 1)
+    {
+        auto bigger = std::make_unique<Table>((table->mask + 1) * 2);
+        for (uint32_t i = 0; i < id; i++)
+        {
+            insertSlot(*bigger, i, entryAt(i).hash);
+        }
+        insertSlot(*bigger, id, hash);
+        m_retired.emplace_back(table);
+        m_table.store(bigger.release(), std::memory_order_release);
+    }
+    else
+    {
+        insertSlot(*table, id, hash);
+    }
+    return InternedString(id);
+}
+
+std::string_view StringPool::view(InternedString handle) const
+{
+    if (!handle.isValid() || handle.id() >= m_count.load(std::memory_order_acquire))
+    {
+        throw tbs::base_error("StringPool: handle does not belong to this pool");
+    }
+    CONST Entry& e = entryAt(handle.id());
+    return std::string_view(e.data, e.length);
+}
+
+size_t StringPool::size() const
+{
+    return m_count.load(std::memory_order_acquire);
+}
+
+StringPool& StringPool::global()
+{
+    static StringPool pool;
+    return pool;
+}
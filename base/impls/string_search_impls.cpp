@@ -0,0 +1,348 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <tbs/strings/Search.h>
+
+#include <cstring>
+#include <queue>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TBS_STRING_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr size_t NPOS = std::string_view::npos;
+
+    /**
+     * 标量短模式串搜索：memchr 定位首字节，再比较其余字节。
+     */
+    size_t findShortScalar(const char* h, size_t hn, const char* n, size_t nn, size_t pos)
+    {
+        while (pos + nn <= hn)
+        {
+            const void* p = std::memchr(h + pos, n[0], hn - nn + 1 - pos);
+            if (p == nullptr)
+            {
+                return NPOS;
+            }
+            pos = static_cast<const char*>(p) - h;
+            if (std::memcmp(h + pos + 1, n + 1, nn - 1) == 0)
+            {
+                return pos;
+            }
+            pos++;
+        }
+        return NPOS;
+    }
+
+#ifdef TBS_STRING_SIMD_X86
+    /*
+     * 首尾字节过滤：同时比较 [i, i + 16) 处的首字节与 [i + nn - 1, i + nn + 15) 处的尾字节，
+     * 两者都相等的位置才是候选，绝大多数块一次比较即可整块跳过。
+     */
+    __attribute__((target("sse2"))) size_t findShortSse2(const char* h, size_t hn, const char* n, size_t nn, size_t pos)
+    {
+        const __m128i first = _mm_set1_epi8(n[0]);
+        const __m128i last = _mm_set1_epi8(n[nn - 1]);
+        size_t i = pos;
+        for (; i + nn - 1 + 16 <= hn; i += 16)
+        {
+            __m128i bf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i));
+            __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + nn - 1));
+            unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl)));
+            while (mask != 0)
+            {
+                unsigned bit = __builtin_ctz(mask);
+                if (std::memcmp(h + i + bit + 1, n + 1, nn - 2) == 0)
+                {
+                    return i + bit;
+                }
+                mask &= mask - 1;
+            }
+        }
+        return findShortScalar(h, hn, n, nn, i);
+    }
+
+    __attribute__((target("avx2"))) size_t findShortAvx2(const char* h, size_t hn, const char* n, size_t nn, size_t pos)
+    {
+        const __m256i first = _mm256_set1_epi8(n[0]);
+        const __m256i last = _mm256_set1_epi8(n[nn - 1]);
+        size_t i = pos;
+        for (; i + nn - 1 + 32 <= hn; i += 32)
+        {
+            __m256i bf = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i));
+            __m256i bl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i + nn - 1));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl))));
+            while (mask != 0)
+            {
+                unsigned bit = __builtin_ctz(mask);
+                if (std::memcmp(h + i + bit + 1, n + 1, nn - 2) == 0)
+                {
+                    return i + bit;
+                }
+                mask &= mask - 1;
+            }
+        }
+        return findShortSse2(h, hn, n, nn, i);
+    }
+#endif
+
+    using ShortKernel = size_t (*)(const char*, size_t, const char*, size_t, size_t);
+
+    ShortKernel shortKernel()
+    {
+        static const ShortKernel k = []
+        {
+#ifdef TBS_STRING_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return static_cast<ShortKernel>(findShortAvx2);
+            }
+            if (__builtin_cpu_supports("sse2"))
+            {
+                return static_cast<ShortKernel>(findShortSse2);
+            }
+#endif
+            return static_cast<ShortKernel>(findShortScalar);
+        }();
+        return k;
+    }
+
+    void buildShiftTable(std::string_view needle, std::array<size_t, 256>& shift)
+    {
+        shift.fill(needle.size());
+        for (size_t i = 0; i + 1 < needle.size(); i++)
+        {
+            shift[static_cast<unsigned char>(needle[i])] = needle.size() - 1 - i;
+        }
+    }
+
+    size_t horspool(std::string_view h, std::string_view n, const std::array<size_t, 256>& shift, size_t pos)
+    {
+        const size_t m = n.size();
+        const char lastChar = n[m - 1];
+        while (pos + m <= h.size())
+        {
+            char c = h[pos + m - 1];
+            if (c == lastChar && std::memcmp(h.data() + pos, n.data(), m - 1) == 0)
+            {
+                return pos;
+            }
+            pos += shift[static_cast<unsigned char>(c)];
+        }
+        return NPOS;
+    }
+
+    /**
+     * 按模式串长度选择策略，shift 只在长模式串时使用。
+     */
+    size_t dispatchFind(std::string_view h, std::string_view n, size_t pos, const std::array<size_t, 256>* shift)
+    {
+        if (n.empty())
+        {
+            return pos <= h.size() ? pos : NPOS;
+        }
+        if (pos >= h.size() || h.size() - pos < n.size())
+        {
+            return NPOS;
+        }
+        if (n.size() == 1)
+        {
+            const void* p = std::memchr(h.data() + pos, n[0], h.size() - pos);
+            return p == nullptr ? NPOS : static_cast<const char*>(p) - h.data();
+        }
+        if (n.size() <= SHORT_NEEDLE_MAX)
+        {
+            return shortKernel()(h.data(), h.size(), n.data(), n.size(), pos);
+        }
+        if (shift != nullptr)
+        {
+            return horspool(h, n, *shift, pos);
+        }
+        std::array<size_t, 256> local;
+        buildShiftTable(n, local);
+        return horspool(h, n, local, pos);
+    }
+} // namespace
+
+size_t fastFind(std::string_view haystack, std::string_view needle, size_t pos)
+{
+    return dispatchFind(haystack, needle, pos, nullptr);
+}
+
+size_t countOccurrences(std::string_view haystack, std::string_view needle)
+{
+    return StringSearcher(needle).count(haystack);
+}
+
+StringSearcher::StringSearcher(std::string_view needle) : m_needle(needle)
+{
+    if (m_needle.size() > SHORT_NEEDLE_MAX)
+    {
+        buildShiftTable(m_needle, m_shift);
+    }
+}
+
+size_t StringSearcher::find(std::string_view haystack, size_t pos) const
+{
+    return dispatchFind(haystack, m_needle, pos, &m_shift);
+}
+
+size_t StringSearcher::count(std::string_view haystack) const
+{
+    if (m_needle.empty())
+    {
+        return 0;
+    }
+    size_t r = 0;
+    for (size_t p = find(haystack); p != NPOS; p = find(haystack, p + m_needle.size()))
+    {
+        r++;
+    }
+    return r;
+}
+
+std::string_view StringSearcher::needle() const
+{
+    return m_needle;
+}
+
+AhoCorasick::AhoCorasick(std::initializer_list<std::string_view> patterns)
+{
+    build(std::vector<std::string_view>(patterns));
+}
+
+void AhoCorasick::build(CONST std::vector<std::string_view>& patterns)
+{
+    constexpr uint32_t NONE = UINT32_MAX;
+    m_delta.assign(256, NONE);
+    m_terminal.assign(1, -1);
+    m_samePattern.assign(patterns.size(), -1);
+    m_lengths.resize(patterns.size());
+
+    // 建立字典树
+    for (size_t id = 0; id < patterns.size(); id++)
+    {
+        std::string_view p = patterns[id];
+        m_lengths[id] = p.size();
+        if (p.empty())
+        {
+            continue;
+        }
+        uint32_t s = 0;
+        for (char ch : p)
+        {
+            size_t slot = s * 256 + static_cast<unsigned char>(ch);
+            if (m_delta[slot] == NONE)
+            {
+                auto next = static_cast<uint32_t>(m_terminal.size());
+                m_delta[slot] = next;
+                m_delta.resize(m_delta.size() + 256, NONE);
+                m_terminal.push_back(-1);
+            }
+            s = m_delta[slot];
+        }
+        if (m_terminal[s] == -1)
+        {
+            m_terminal[s] = static_cast<int32_t>(id);
+        }
+        else
+        {
+            int32_t t = m_terminal[s];
+            while (m_samePattern[t] != -1)
+            {
+                t = m_samePattern[t];
+            }
+            m_samePattern[t] = static_cast<int32_t>(id);
+        }
+    }
+
+    // 广度优先计算失败链，并把缺失的转移补全为确定性自动机
+    const size_t states = m_terminal.size();
+    std::vector<uint32_t> fail(states, 0);
+    m_dictLink.assign(states, -1);
+    std::queue<uint32_t> q;
+    for (size_t c = 0; c < 256; c++)
+    {
+        if (m_delta[c] == NONE)
+        {
+            m_delta[c] = 0;
+        }
+        else
+        {
+            q.push(m_delta[c]);
+        }
+    }
+    while (!q.empty())
+    {
+        uint32_t s = q.front();
+        q.pop();
+        for (size_t c = 0; c < 256; c++)
+        {
+            uint32_t& t = m_delta[s * 256 + c];
+            uint32_t viaFail = m_delta[fail[s] * 256 + c];
+            if (t == NONE)
+            {
+                t = viaFail;
+                continue;
+            }
+            fail[t] = viaFail;
+            m_dictLink[t] = m_terminal[viaFail] != -1 ? static_cast<int32_t>(viaFail) : m_dictLink[viaFail];
+            q.push(t);
+        }
+    }
+}
+
+void AhoCorasick::foreachMatch(std::string_view text, CONST std::function<bool(CONST Match&)>& f) const
+{
+    uint32_t state = 0;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        state = m_delta[state * 256 + static_cast<unsigned char>(text[i])];
+        int32_t s = m_terminal[state] != -1 ? static_cast<int32_t>(state) : m_dictLink[state];
+        for (; s != -1; s = m_dictLink[s])
+        {
+            for (int32_t p = m_terminal[s]; p != -1; p = m_samePattern[p])
+            {
+                if (!f(Match{i + 1 - m_lengths[p], static_cast<size_t>(p), m_lengths[p]}))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+std::vector<AhoCorasick::Match> AhoCorasick::findAll(std::string_view text) const
+{
+    std::vector<Match> r;
+    foreachMatch(text,
+                 [&r](CONST Match& m)
+                 {
+                     r.push_back(m);
+                     return true;
+                 });
+    return r;
+}
+
+bool AhoCorasick::containsAny(std::string_view text) const
+{
+    uint32_t state = 0;
+    for (char c : text)
+    {
+        state = m_delta[state * 256 + static_cast<unsigned char>(c)];
+        if (m_terminal[state] != -1 || m_dictLink[state] != -1)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t AhoCorasick::patternCount() const
+{
+    return m_lengths.size();
+}
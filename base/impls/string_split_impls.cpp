@@ -0,0 +1,231 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <tbs/strings/Split.h>
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TBS_STRING_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * 标量路径：逐字节与所有分隔符比较，返回偏移，未找到返回 n。
+     */
+    size_t findAnyScalar(const char* p, size_t n, const char* chars, size_t k)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            for (size_t j = 0; j < k; j++)
+            {
+                if (p[i] == chars[j])
+                {
+                    return i;
+                }
+            }
+        }
+        return n;
+    }
+
+#ifdef TBS_STRING_SIMD_X86
+    __attribute__((target("sse2"))) size_t findAnySse2(const char* p, size_t n, const char* chars, size_t k)
+    {
+        __m128i needles[DelimiterSet::MAX_SIMD_CHARS];
+        for (size_t j = 0; j < k; j++)
+        {
+            needles[j] = _mm_set1_epi8(chars[j]);
+        }
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i hit = _mm_cmpeq_epi8(v, needles[0]);
+            for (size_t j = 1; j < k; j++)
+            {
+                hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, needles[j]));
+            }
+            unsigned mask = _mm_movemask_epi8(hit);
+            if (mask != 0)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + findAnyScalar(p + i, n - i, chars, k);
+    }
+
+    __attribute__((target("avx2"))) size_t findAnyAvx2(const char* p, size_t n, const char* chars, size_t k)
+    {
+        __m256i needles[DelimiterSet::MAX_SIMD_CHARS];
+        for (size_t j = 0; j < k; j++)
+        {
+            needles[j] = _mm256_set1_epi8(chars[j]);
+        }
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            __m256i hit = _mm256_cmpeq_epi8(v, needles[0]);
+            for (size_t j = 1; j < k; j++)
+            {
+                hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(v, needles[j]));
+            }
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+            if (mask != 0)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + findAnySse2(p + i, n - i, chars, k);
+    }
+#endif
+
+    using FindAnyKernel = size_t (*)(const char*, size_t, const char*, size_t);
+
+    FindAnyKernel findAnyKernel()
+    {
+        static const FindAnyKernel k = []
+        {
+#ifdef TBS_STRING_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return static_cast<FindAnyKernel>(findAnyAvx2);
+            }
+            if (__builtin_cpu_supports("sse2"))
+            {
+                return static_cast<FindAnyKernel>(findAnySse2);
+            }
+#endif
+            return static_cast<FindAnyKernel>(findAnyScalar);
+        }();
+        return k;
+    }
+} // namespace
+
+DelimiterSet::DelimiterSet(std::string_view chars) : DelimiterSet(CharSet(chars))
+{
+}
+
+DelimiterSet::DelimiterSet(CONST CharSet& chars) : m_set(chars)
+{
+    if (m_set.size() > MAX_SIMD_CHARS)
+    {
+        return;
+    }
+    for (unsigned u = 0; u < 256; u++)
+    {
+        if (m_set.contains(static_cast<char>(u)))
+        {
+            m_chars[m_count++] = static_cast<char>(u);
+        }
+    }
+}
+
+size_t DelimiterSet::find(std::string_view str, size_t pos) const
+{
+    if (pos >= str.size())
+    {
+        return std::string_view::npos;
+    }
+    if (m_count == 0)
+    {
+        return m_set.findFirstOf(str, pos);
+    }
+    if (m_count == 1)
+    {
+        const void* p = std::memchr(str.data() + pos, m_chars[0], str.size() - pos);
+        return p == nullptr ? std::string_view::npos : static_cast<const char*>(p) - str.data();
+    }
+    size_t off = findAnyKernel()(str.data() + pos, str.size() - pos, m_chars, m_count);
+    return off == str.size() - pos ? std::string_view::npos : pos + off;
+}
+
+SplitRange split(std::string_view text, std::string_view delimiters)
+{
+    return SplitRange(text, DelimiterSet(delimiters), false);
+}
+
+SplitRange split(std::string_view text, CONST CharSet& delimiters)
+{
+    return SplitRange(text, DelimiterSet(delimiters), false);
+}
+
+SplitRange tokenize(std::string_view text, std::string_view delimiters)
+{
+    return SplitRange(text, DelimiterSet(delimiters), true);
+}
+
+SplitRange tokenize(std::string_view text, CONST CharSet& delimiters)
+{
+    return SplitRange(text, DelimiterSet(delimiters), true);
+}
+
+std::string CsvField::value(char quote) const
+{
+    if (!escaped)
+    {
+        return std::string(raw);
+    }
+    std::string r;
+    r.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); i++)
+    {
+        r.push_back(raw[i]);
+        if (raw[i] == quote && i + 1 < raw.size() && raw[i + 1] == quote)
+        {
+            i++;
+        }
+    }
+    return r;
+}
+
+void CsvFieldRange::parse(iterator& it, size_t pos) const
+{
+    const size_t n = m_record.size();
+    const char* s = m_record.data();
+    it.m_pos = pos;
+    it.m_field = CsvField();
+    size_t scanFrom = pos;
+    if (pos < n && s[pos] == m_quote)
+    {
+        it.m_field.quoted = true;
+        size_t i = pos + 1;
+        while (true)
+        {
+            const void* q = i < n ? std::memchr(s + i, m_quote, n - i) : nullptr;
+            if (q == nullptr)
+            {
+                // 未闭合的引号，字段延伸到记录末尾
+                it.m_field.raw = m_record.substr(pos + 1);
+                it.m_last = true;
+                return;
+            }
+            size_t qi = static_cast<const char*>(q) - s;
+            if (qi + 1 < n && s[qi + 1] == m_quote)
+            {
+                it.m_field.escaped = true;
+                i = qi + 2;
+                continue;
+            }
+            it.m_field.raw = m_record.substr(pos + 1, qi - pos - 1);
+            scanFrom = qi + 1;
+            break;
+        }
+    }
+    const void* d = scanFrom < n ? std::memchr(s + scanFrom, m_delimiter, n - scanFrom) : nullptr;
+    size_t end = d == nullptr ? n : static_cast<const char*>(d) - s;
+    if (!it.m_field.quoted)
+    {
+        it.m_field.raw = m_record.substr(pos, end - pos);
+    }
+    it.m_last = d == nullptr;
+    it.m_next = end + 1;
+}
+
+CsvFieldRange splitCsv(std::string_view record, char delimiter, char quote)
+{
+    return CsvFieldRange(record, delimiter, quote);
+}
@@ -0,0 +1,357 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <tbs/strings/Utf.h>
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * 从 p 开始的连续 ASCII 字节数（只检查到 n 为止）。
+     */
+    size_t asciiPrefix(const unsigned char* p, size_t n)
+    {
+        size_t i = 0;
+#ifdef __SSE2__
+        for (; i + 16 <= n; i += 16)
+        {
+            unsigned mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+            if (mask != 0)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+#endif
+        while (i < n && p[i] < 0x80)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    /**
+     * 把 n 个 ASCII 字节拓宽为 16 位或 32 位码元。
+     */
+    template <typename CharT>
+    void widenAscii(const unsigned char* p, size_t n, CharT* out)
+    {
+        size_t i = 0;
+#ifdef __SSE2__
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i lo = _mm_unpacklo_epi8(v, zero);
+            __m128i hi = _mm_unpackhi_epi8(v, zero);
+            if constexpr (sizeof(CharT) == 2)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lo);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), hi);
+            }
+            else
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+            }
+        }
+#endif
+        for (; i < n; i++)
+        {
+            out[i] = static_cast<CharT>(p[i]);
+        }
+    }
+
+    /**
+     * 解码一个非 ASCII 的 UTF-8 序列，成功时前移 p 并返回 true。
+     */
+    bool decodeMultiByte(const unsigned char*& p, const unsigned char* end, char32_t& cp)
+    {
+        unsigned char b0 = p[0];
+        size_t len;
+        char32_t min;
+        if (b0 >= 0xC2 && b0 <= 0xDF)
+        {
+            len = 2;
+            cp = b0 & 0x1F;
+            min = 0x80;
+        }
+        else if ((b0 & 0xF0) == 0xE0)
+        {
+            len = 3;
+            cp = b0 & 0x0F;
+            min = 0x800;
+        }
+        else if (b0 >= 0xF0 && b0 <= 0xF4)
+        {
+            len = 4;
+            cp = b0 & 0x07;
+            min = 0x10000;
+        }
+        else
+        {
+            return false;
+        }
+        if (static_cast<size_t>(end - p) < len)
+        {
+            return false;
+        }
+        for (size_t i = 1; i < len; i++)
+        {
+            if ((p[i] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+            cp = (cp << 6) | (p[i] & 0x3F);
+        }
+        if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+        {
+            return false;
+        }
+        p += len;
+        return true;
+    }
+
+    /**
+     * 遍历 UTF-8 字符串：连续的 ASCII 段交给 onAscii(ptr, len)，其余码点交给 onCodePoint(cp)。
+     */
+    template <typename OnAscii, typename OnCodePoint>
+    bool walkUtf8(std::string_view str, OnAscii&& onAscii, OnCodePoint&& onCodePoint)
+    {
+        auto p = reinterpret_cast<const unsigned char*>(str.data());
+        const auto end = p + str.size();
+        while (p < end)
+        {
+            size_t a = asciiPrefix(p, end - p);
+            if (a > 0)
+            {
+                onAscii(p, a);
+                p += a;
+                continue;
+            }
+            char32_t cp;
+            if (!decodeMultiByte(p, end, cp))
+            {
+                return false;
+            }
+            onCodePoint(cp);
+        }
+        return true;
+    }
+
+    template <typename String>
+    Option<String> utf8ToUnits(std::string_view str)
+    {
+        using CharT = typename String::value_type;
+        constexpr bool isUtf16 = sizeof(CharT) == 2;
+        size_t units = 0;
+        bool ok = walkUtf8(
+            str,
+            [&units](const unsigned char*, size_t n) { units += n; },
+            [&units](char32_t cp) { units += (isUtf16 && cp >= 0x10000) ? 2 : 1; });
+        if (!ok)
+        {
+            return Option<String>();
+        }
+        String r(units, CharT());
+        CharT* out = r.data();
+        walkUtf8(
+            str,
+            [&out](const unsigned char* p, size_t n)
+            {
+                widenAscii(p, n, out);
+                out += n;
+            },
+            [&out](char32_t cp)
+            {
+                if (isUtf16 && cp >= 0x10000)
+                {
+                    cp -= 0x10000;
+                    *out++ = static_cast<CharT>(0xD800 + (cp >> 10));
+                    *out++ = static_cast<CharT>(0xDC00 + (cp & 0x3FF));
+                }
+                else
+                {
+                    *out++ = static_cast<CharT>(cp);
+                }
+            });
+        return Option<String>(std::move(r));
+    }
+
+    /**
+     * 从 UTF-16 / UTF-32 码元序列中取下一个码点，非法时返回 false。
+     */
+    template <typename CharT>
+    bool nextCodePoint(const CharT*& p, const CharT* end, char32_t& cp)
+    {
+        cp = static_cast<char32_t>(*p++);
+        if constexpr (sizeof(CharT) == 2)
+        {
+            cp &= 0xFFFF;
+            if (cp >= 0xD800 && cp <= 0xDBFF)
+            {
+                if (p == end)
+                {
+                    return false;
+                }
+                char32_t lo = static_cast<char32_t>(*p) & 0xFFFF;
+                if (lo < 0xDC00 || lo > 0xDFFF)
+                {
+                    return false;
+                }
+                p++;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                return true;
+            }
+        }
+        return cp <= 0x10FFFF && (cp < 0xD800 || cp > 0xDFFF);
+    }
+
+    /**
+     * 从 p 开始连续 ASCII 码元的个数。
+     */
+    template <typename CharT>
+    size_t asciiUnitPrefix(const CharT* p, size_t n)
+    {
+        size_t i = 0;
+#ifdef __SSE2__
+        if constexpr (sizeof(CharT) == 2)
+        {
+            const __m128i high = _mm_set1_epi16(static_cast<short>(0xFF80));
+            for (; i + 8 <= n; i += 8)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, high), _mm_setzero_si128())) != 0xFFFF)
+                {
+                    break;
+                }
+            }
+        }
+#endif
+        while (i < n && static_cast<char32_t>(p[i]) < 0x80)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    template <typename CharT>
+    Option<std::string> unitsToUtf8(const CharT* data, size_t n)
+    {
+        const CharT* const end = data + n;
+        size_t bytes = 0;
+        for (const CharT* p = data; p < end;)
+        {
+            size_t a = asciiUnitPrefix(p, end - p);
+            bytes += a;
+            p += a;
+            if (p == end)
+            {
+                break;
+            }
+            char32_t cp;
+            if (!nextCodePoint(p, end, cp))
+            {
+                return Option<std::string>();
+            }
+            bytes += cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+        }
+        std::string r(bytes, '\0');
+        char* out = r.data();
+        for (const CharT* p = data; p < end;)
+        {
+            size_t a = asciiUnitPrefix(p, end - p);
+            for (size_t i = 0; i < a; i++)
+            {
+                out[i] = static_cast<char>(p[i]);
+            }
+            out += a;
+            p += a;
+            if (p == end)
+            {
+                break;
+            }
+            char32_t cp;
+            nextCodePoint(p, end, cp);
+            if (cp < 0x800)
+            {
+                *out++ = static_cast<char>(0xC0 | (cp >> 6));
+            }
+            else if (cp < 0x10000)
+            {
+                *out++ = static_cast<char>(0xE0 | (cp >> 12));
+                *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            }
+            else
+            {
+                *out++ = static_cast<char>(0xF0 | (cp >> 18));
+                *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            }
+            *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        return Option<std::string>(std::move(r));
+    }
+} // namespace
+
+bool isValidUtf8(std::string_view str)
+{
+    return walkUtf8(str, [](const unsigned char*, size_t) {}, [](char32_t) {});
+}
+
+Option<size_t> utf16LengthOfUtf8(std::string_view str)
+{
+    size_t units = 0;
+    bool ok = walkUtf8(
+        str,
+        [&units](const unsigned char*, size_t n) { units += n; },
+        [&units](char32_t cp) { units += cp >= 0x10000 ? 2 : 1; });
+    return ok ? Option<size_t>(units) : Option<size_t>();
+}
+
+Option<size_t> codePointCountOfUtf8(std::string_view str)
+{
+    size_t count = 0;
+    bool ok = walkUtf8(
+        str,
+        [&count](const unsigned char*, size_t n) { count += n; },
+        [&count](char32_t) { count++; });
+    return ok ? Option<size_t>(count) : Option<size_t>();
+}
+
+Option<std::u16string> utf8ToUtf16(std::string_view str)
+{
+    return utf8ToUnits<std::u16string>(str);
+}
+
+Option<std::u32string> utf8ToUtf32(std::string_view str)
+{
+    return utf8ToUnits<std::u32string>(str);
+}
+
+Option<std::wstring> utf8ToWide(std::string_view str)
+{
+    return utf8ToUnits<std::wstring>(str);
+}
+
+Option<std::string> utf16ToUtf8(std::u16string_view str)
+{
+    return unitsToUtf8(str.data(), str.size());
+}
+
+Option<std::string> utf32ToUtf8(std::u32string_view str)
+{
+    return unitsToUtf8(str.data(), str.size());
+}
+
+Option<std::string> wideToUtf8(std::wstring_view str)
+{
+    return unitsToUtf8(str.data(), str.size());
+}
@@ -2,6 +2,124 @@
 // Created by abstergo on 24-11-11.
 //
 #include <tbs/string_utils.h>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TBS_STRING_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+/*
+ * 字节分类与大小写转换内核。
+ *
+ * 区间判断 lo <= c <= hi 通过偏移 (0x80 - lo) 转成一次有符号比较：偏移后区间起点落在 -128，
+ * 因此只需判断 c' < -128 + (hi - lo) + 1，SSE2 / AVX2 每条指令可以处理 16 / 32 字节。
+ * fold 为 true 时先把每个字节或上 0x20，把大写字母折叠为小写（非字母字节不会因此落入区间）。
+ * 大小写转换对落在区间内的字节异或 0x20。
+ */
+inline bool inRange(unsigned char c, unsigned char lo, unsigned char hi) {
+  return static_cast<unsigned char>(c - lo) <= static_cast<unsigned char>(hi - lo);
+}
+
+bool allInRangeScalar(const char *p, size_t n, char lo, char hi, bool fold) {
+  for (size_t i = 0; i < n; i++) {
+    unsigned char c = static_cast<unsigned char>(p[i]) | (fold ? 0x20 : 0);
+    if (!inRange(c, lo, hi))
+      return false;
+  }
+  return true;
+}
+
+void convertCaseScalar(char *p, size_t n, char lo, char hi) {
+  for (size_t i = 0; i < n; i++) {
+    if (inRange(p[i], lo, hi)) {
+      p[i] ^= 0x20;
+    }
+  }
+}
+
+#ifdef TBS_STRING_SIMD_X86
+__attribute__((target("sse2"))) bool allInRangeSse2(const char *p, size_t n, char lo, char hi, bool fold) {
+  const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - static_cast<unsigned char>(lo)));
+  const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + (hi - lo) + 1));
+  const __m128i foldMask = _mm_set1_epi8(fold ? 0x20 : 0);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)), foldMask);
+    __m128i in = _mm_cmplt_epi8(_mm_add_epi8(v, bias), limit);
+    if (_mm_movemask_epi8(in) != 0xFFFF)
+      return false;
+  }
+  return allInRangeScalar(p + i, n - i, lo, hi, fold);
+}
+
+__attribute__((target("sse2"))) void convertCaseSse2(char *p, size_t n, char lo, char hi) {
+  const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - static_cast<unsigned char>(lo)));
+  const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + (hi - lo) + 1));
+  const __m128i flip = _mm_set1_epi8(0x20);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+    __m128i in = _mm_cmplt_epi8(_mm_add_epi8(v, bias), limit);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p + i), _mm_xor_si128(v, _mm_and_si128(in, flip)));
+  }
+  convertCaseScalar(p + i, n - i, lo, hi);
+}
+
+__attribute__((target("avx2"))) bool allInRangeAvx2(const char *p, size_t n, char lo, char hi, bool fold) {
+  const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - static_cast<unsigned char>(lo)));
+  const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + (hi - lo) + 1));
+  const __m256i foldMask = _mm256_set1_epi8(fold ? 0x20 : 0);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i)), foldMask);
+    // limit > v' 即 v' < limit
+    __m256i in = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, bias));
+    if (static_cast<unsigned>(_mm256_movemask_epi8(in)) != 0xFFFFFFFFu)
+      return false;
+  }
+  return allInRangeSse2(p + i, n - i, lo, hi, fold);
+}
+
+__attribute__((target("avx2"))) void convertCaseAvx2(char *p, size_t n, char lo, char hi) {
+  const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - static_cast<unsigned char>(lo)));
+  const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + (hi - lo) + 1));
+  const __m256i flip = _mm256_set1_epi8(0x20);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+    __m256i in = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, bias));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p + i), _mm256_xor_si256(v, _mm256_and_si256(in, flip)));
+  }
+  convertCaseSse2(p + i, n - i, lo, hi);
+}
+#endif
+
+/*
+ * 运行时根据 CPU 特性选择一次内核，之后的调用只是一次间接跳转。
+ */
+struct StringKernels {
+  bool (*allInRange)(const char *, size_t, char, char, bool);
+  void (*convertCase)(char *, size_t, char, char);
+};
+
+const StringKernels &kernels() {
+  static const StringKernels k = [] {
+#ifdef TBS_STRING_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return StringKernels{allInRangeAvx2, convertCaseAvx2};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+      return StringKernels{allInRangeSse2, convertCaseSse2};
+    }
+#endif
+    return StringKernels{allInRangeScalar, convertCaseScalar};
+  }();
+  return k;
+}
+} // namespace
 
 bool isEmpty(const char *str) {
   return str == nullptr || str[0] == '\0';
@@ -19,19 +137,22 @@ bool isNumber(const char *str) {
   if (isEmpty(str)) {
     return false;
   }
-  while (*str++)
-    if (!isNumber(*str))
-      return false;
-  return true;
+  return isNumber(std::string_view(str));
 }
 bool isNumber(const std::string &str) {
-  return isNumber(str.c_str());
+  return isNumber(std::string_view(str));
+}
+bool isNumber(std::string_view str) {
+  return !str.empty() && kernels().allInRange(str.data(), str.size(), '0', '9', false);
 }
 bool isNumber(const std::wstring &str) {
   return isNumber(str.c_str());
 }
 bool isNumber(const wchar_t *str) {
-  while (*str++)
+  if (isEmpty(str)) {
+    return false;
+  }
+  for (; *str; str++)
     if (!isNumber(*str))
       return false;
   return true;
@@ -46,19 +167,19 @@ bool isNumber(const char *str, int start, int end) {
   if (isEmpty(str)) {
     return false;
   }
-  for (int i = start; i < end; i++)
-    if (!isNumber(str[i]))
-      return false;
-  return true;
+  return end <= start || kernels().allInRange(str + start, end - start, '0', '9', false);
 }
 bool isCharacters(const char *str) {
-  while (*str++)
-    if (!isCharacters(*str))
-      return false;
-  return true;
+  if (isEmpty(str)) {
+    return false;
+  }
+  return isCharacters(std::string_view(str));
 }
 bool isCharacters(const std::string &str) {
-  return isCharacters(str.c_str());
+  return isCharacters(std::string_view(str));
+}
+bool isCharacters(std::string_view str) {
+  return !str.empty() && kernels().allInRange(str.data(), str.size(), 'a', 'z', true);
 }
 bool isCharacters(const std::wstring &str) {
   return isCharacters(str.c_str());
@@ -67,7 +188,7 @@ bool isCharacters(const wchar_t *str) {
   if (isEmpty(str)) {
     return false;
   }
-  while (*str++) {
+  for (; *str; str++) {
     if (!isCharacters(*str))
       return false;
   }
@@ -83,28 +204,28 @@ bool isCharacters(const char *str, int start, int end) {
   if (isEmpty(str)) {
     return false;
   }
-  for (int i = start; i < end; i++)
-    if (!isCharacters(str[i]))
-      return false;
-  return true;
+  return end <= start || kernels().allInRange(str + start, end - start, 'a', 'z', true);
 }
 size_t strLength(const char *str) {
-  size_t len = 0;
-  while (*str++)
-    len++;
-  return len;
+  // libc 的 strlen 已按平台向量化，并且正确处理跨页读取
+  return std::strlen(str);
 }
-std::string toLower(const char *str) {
+void toLowerInPlace(char *str, size_t len) {
+  kernels().convertCase(str, len, 'A', 'Z');
+}
+void toLowerInPlace(std::string &str) {
+  toLowerInPlace(str.data(), str.size());
+}
+std::string toLower(std::string_view str) {
   std::string res(str);
-  for (char &c : res) {
-    if (c >= 'A' && c <= 'Z') {
-      c += 32;
-    }
-  }
+  toLowerInPlace(res);
   return res;
 }
+std::string toLower(const char *str) {
+  return toLower(std::string_view(str));
+}
 std::string toLower(const std::string &str) {
-  return toLower(str.c_str());
+  return toLower(std::string_view(str));
 }
 std::wstring toLower(const wchar_t *str) {
   std::wstring res(str);
@@ -118,17 +239,22 @@ std::wstring toLower(const wchar_t *str) {
 std::wstring toLower(const std::wstring &str) {
   return toLower(str.c_str());
 }
-std::string toUpper(const char *str) {
+void toUpperInPlace(char *str, size_t len) {
+  kernels().convertCase(str, len, 'a', 'z');
+}
+void toUpperInPlace(std::string &str) {
+  toUpperInPlace(str.data(), str.size());
+}
+std::string toUpper(std::string_view str) {
   std::string res(str);
-  for (char &c : res) {
-    if (c >= 'a' && c <= 'z') {
-      c -= 32;
-    }
-  }
+  toUpperInPlace(res);
   return res;
 }
+std::string toUpper(const char *str) {
+  return toUpper(std::string_view(str));
+}
 std::string toUpper(const std::string &str) {
-  return toUpper(str.c_str());
+  return toUpper(std::string_view(str));
 }
 std::wstring toUpper(const wchar_t *str) {
   std::wstring res(str);
@@ -142,230 +268,160 @@ std::wstring toUpper(const wchar_t *str) {
 std::wstring toUpper(const std::wstring &str) {
   return toUpper(str.c_str());
 }
-#include <unordered_set>
-#include <cstring>
+std::string_view trimLeftView(std::string_view str, const CharSet &chars) {
+  size_t b = chars.findFirstNotOf(str);
+  return b == std::string_view::npos ? std::string_view() : str.substr(b);
+}
+std::string_view trimLeftView(std::string_view str, std::string_view chars) {
+  return trimLeftView(str, CharSet(chars));
+}
+std::string_view trimRightView(std::string_view str, const CharSet &chars) {
+  size_t e = chars.findLastNotOf(str);
+  return e == std::string_view::npos ? std::string_view() : str.substr(0, e + 1);
+}
+std::string_view trimRightView(std::string_view str, std::string_view chars) {
+  return trimRightView(str, CharSet(chars));
+}
+std::string_view trimView(std::string_view str, const CharSet &chars) {
+  return trimRightView(trimLeftView(str, chars), chars);
+}
+std::string_view trimView(std::string_view str, std::string_view chars) {
+  return trimView(str, CharSet(chars));
+}
 std::string trimLeft(const char *str, const char *chars) {
-  std::string res;
-  std::unordered_set<char> charsSet;
-  while (*chars++)
-    charsSet.insert(*chars);
-  bool begin = true;
-  for (int i = 0; str[i] != '\0'; i++) {
-    if (begin) {
-      if (charsSet.count(res[i]) > 0) {
-        continue;
-      } else {
-        begin = false;
-      }
-    }
-    res += str[i];
-  }
-  return res;
+  return std::string(trimLeftView(str, chars));
 }
 std::string trimLeft(const std::string &str, const char *chars) {
-  return trimLeft(str.c_str(), chars);
+  return std::string(trimLeftView(std::string_view(str), chars));
 }
 std::wstring trimLeft(const wchar_t *str, const wchar_t *chars) {
-  std::wstring res;
-  std::unordered_set<wchar_t> charsSet;
-  while (*chars++)
-    charsSet.insert(*chars);
-  bool begin = true;
-  for (int i = 0; str[i] != L'\0'; i++) {
-    if (begin) {
-      if (charsSet.count(res[i]) > 0) {
-        continue;
-      } else {
-        begin = false;
-      }
-    }
-    res += str[i];
-  }
-  return res;
+  return trimLeft(std::wstring(str), chars);
 }
 std::wstring trimLeft(const std::wstring &str, const wchar_t *chars) {
-  return trimLeft(str.c_str(), chars);
+  size_t b = str.find_first_not_of(chars);
+  return b == std::wstring::npos ? std::wstring() : str.substr(b);
 }
 std::string trimRight(const char *str, const char *chars) {
-  return trimRight(std::string(str), chars);
+  return std::string(trimRightView(str, chars));
 }
 std::string trimRight(const std::string &str, const char *chars) {
-  std::string res(str);
-  std::unordered_set<char> charsSet;
-  while (*chars++)
-    charsSet.insert(*chars);
-
-  while (!res.empty() && charsSet.count(res.back()) > 0) {
-    res.pop_back();
-  }
-  return res;
+  return std::string(trimRightView(std::string_view(str), chars));
 }
 std::wstring trimRight(const wchar_t *str, const wchar_t *chars) {
   return trimRight(std::wstring(str), chars);
 }
 std::wstring trimRight(const std::wstring &str, const wchar_t *chars) {
-  std::wstring res(str);
-  std::unordered_set<wchar_t> charsSet;
-  while (*chars++)
-    charsSet.insert(*chars);
-
-  while (!res.empty() && charsSet.count(res.back()) > 0) {
-    res.pop_back();
-  }
-  return res;
+  size_t e = str.find_last_not_of(chars);
+  return e == std::wstring::npos ? std::wstring() : str.substr(0, e + 1);
 }
 std::string trim(const char *str, const char *chars) {
-  std::string res = trimLeft(str, chars);
-  res = trimRight(res, chars);
-  return res;
+  return std::string(trimView(str, chars));
 }
 std::string trim(const std::string &str, const char *chars) {
-  return trim(str.c_str(), chars);
+  return std::string(trimView(std::string_view(str), chars));
 }
 std::wstring trim(const wchar_t *str, const wchar_t *chars) {
-  std::wstring res = trimLeft(str, chars);
-  res = trimRight(res, chars);
-  return res;
+  return trim(std::wstring(str), chars);
 }
 std::wstring trim(const std::wstring &str, const wchar_t *chars) {
-  return trim(str.c_str(), chars);
+  size_t b = str.find_first_not_of(chars);
+  if (b == std::wstring::npos) {
+    return std::wstring();
+  }
+  size_t e = str.find_last_not_of(chars);
+  return str.substr(b, e - b + 1);
 }
-std::string replace(const char *str, const char *oldStr, const char *newStr) {
-  std::string res(str);
-  size_t oldStrLen = strLength(oldStr);
-  res.replace(res.find(oldStr), oldStrLen, newStr);
+std::string replace(std::string_view str, std::string_view oldStr, std::string_view newStr) {
+  size_t pos = oldStr.empty() ? std::string_view::npos : fastFind(str, oldStr);
+  if (pos == std::string_view::npos) {
+    return std::string(str);
+  }
+  std::string res;
+  res.reserve(str.size() - oldStr.size() + newStr.size());
+  res.append(str.substr(0, pos)).append(newStr).append(str.substr(pos + oldStr.size()));
   return res;
 }
+std::string replace(const char *str, const char *oldStr, const char *newStr) {
+  return replace(std::string_view(str), std::string_view(oldStr), std::string_view(newStr));
+}
 std::string replace(const std::string &str, const char *oldStr, const char *newStr) {
-  return replace(str.c_str(), oldStr, newStr);
+  return replace(std::string_view(str), std::string_view(oldStr), std::string_view(newStr));
 }
 std::wstring replace(const wchar_t *str, const wchar_t *oldStr, const wchar_t *newStr) {
   std::wstring res(str);
-  size_t oldStrLen = strLength(oldStr);
-  res.replace(res.find(oldStr), oldStrLen, newStr);
+  size_t pos = res.find(oldStr);
+  if (pos != std::wstring::npos && !isEmpty(oldStr)) {
+    res.replace(pos, strLength(oldStr), newStr);
+  }
   return res;
 }
 std::wstring replace(const std::wstring &str, const wchar_t *oldStr, const wchar_t *newStr) {
   return replace(str.c_str(), oldStr, newStr);
 }
 std::string replace(const char *str, const char *oldStr, const std::string &newStr) {
-  return replace(str, oldStr, newStr.c_str());
+  return replace(std::string_view(str), std::string_view(oldStr), std::string_view(newStr));
 }
-size_t find(const char *str, const char *subStr, bool &found) {
-  found = false;
-  if (isEmpty(str)) {
-    return 0;
-  }
-  size_t subStrLen = strLength(subStr);
-  if (subStrLen == 0) {
-    return 0;
+std::string replaceAll(std::string_view str, std::string_view oldStr, std::string_view newStr) {
+  if (oldStr.empty()) {
+    return std::string(str);
   }
-  size_t strLen = strLength(str);
-  for (int i = 0; str[i] != '\0'; i++) {
-    if (str[i] != subStr[0]) {
-      continue;
-    }
-    if (i + subStrLen > strLen) {
-      return 0;
-    }
-    for (int j = 1; j < subStrLen; j++) {
-      if (str[i + j] != subStr[j]) {
-        break;
-      }
-      if (j == subStrLen - 1) {
-        found = true;
-        return i;
-      }
+  StringSearcher searcher(oldStr);
+  if (oldStr.size() == newStr.size()) {
+    // 等长替换直接在拷贝上覆盖，不需要计数
+    std::string res(str);
+    for (size_t p = searcher.find(str); p != std::string_view::npos; p = searcher.find(str, p + oldStr.size())) {
+      std::memcpy(res.data() + p, newStr.data(), newStr.size());
     }
+    return res;
+  }
+  size_t n = searcher.count(str);
+  if (n == 0) {
+    return std::string(str);
+  }
+  // 先计算结果长度，一次分配后按顺序写出每一段
+  std::string res(str.size() - n * oldStr.size() + n * newStr.size(), '\0');
+  char *out = res.data();
+  size_t last = 0;
+  for (size_t p = searcher.find(str); p != std::string_view::npos; p = searcher.find(str, last)) {
+    std::memcpy(out, str.data() + last, p - last);
+    out += p - last;
+    std::memcpy(out, newStr.data(), newStr.size());
+    out += newStr.size();
+    last = p + oldStr.size();
   }
-  return 0;
+  std::memcpy(out, str.data() + last, str.size() - last);
+  return res;
 }
-size_t find(const std::string &str, const char *subStr, bool &found) {
-  found = false;
-  if (isEmpty(str)) {
+size_t find(std::string_view str, std::string_view subStr, bool &found) {
+  size_t pos = subStr.empty() ? std::string_view::npos : fastFind(str, subStr);
+  found = pos != std::string_view::npos;
+  return found ? pos : 0;
+}
+size_t find(const char *str, const char *subStr, bool &found) {
+  if (isEmpty(str) || isEmpty(subStr)) {
+    found = false;
     return 0;
   }
-  size_t subStrLen = strLength(subStr);
-  if (subStrLen == 0) {
+  return find(std::string_view(str), std::string_view(subStr), found);
+}
+size_t find(const std::string &str, const char *subStr, bool &found) {
+  if (isEmpty(subStr)) {
+    found = false;
     return 0;
   }
-  size_t strLen = str.size();
-  for (int i = 0; str[i] != '\0'; i++) {
-    if (str[i] != subStr[0]) {
-      continue;
-    }
-    if (i + subStrLen > strLen) {
-      return 0;
-    }
-    for (int j = 1; j < subStrLen; j++) {
-      if (str[i + j] != subStr[j]) {
-        break;
-      }
-      if (j == subStrLen - 1) {
-        found = true;
-        return i;
-      }
-    }
-  }
-  return 0;
+  return find(std::string_view(str), std::string_view(subStr), found);
 }
 size_t find(const wchar_t *str, const wchar_t *subStr, bool &found) {
-  found = false;
   if (isEmpty(str)) {
+    found = false;
     return 0;
   }
-  size_t subStrLen = strLength(subStr);
-  if (subStrLen == 0) {
-    return 0;
-  }
-  size_t strLen = strLength(str);
-  for (int i = 0; str[i] != '\0'; i++) {
-    if (str[i] != subStr[0]) {
-      continue;
-    }
-    if (i + subStrLen > strLen) {
-      return 0;
-    }
-    for (int j = 1; j < subStrLen; j++) {
-      if (str[i + j] != subStr[j]) {
-        break;
-      }
-      if (j == subStrLen - 1) {
-        found = true;
-        return i;
-      }
-    }
-  }
-  return 0;
+  return find(std::wstring(str), subStr, found);
 }
 size_t find(const std::wstring &str, const wchar_t *subStr, bool &found) {
-  found = false;
-  if (isEmpty(str)) {
-    return 0;
-  }
-  size_t subStrLen = strLength(subStr);
-  if (subStrLen == 0) {
-    return 0;
-  }
-  size_t strLen = str.size();
-  for (int i = 0; str[i] != '\0'; i++) {
-    if (str[i] != subStr[0]) {
-      continue;
-    }
-    if (i + subStrLen > strLen) {
-      return 0;
-    }
-    for (int j = 1; j < subStrLen; j++) {
-      if (str[i + j] != subStr[j]) {
-        break;
-      }
-      if (j == subStrLen - 1) {
-        found = true;
-        return i;
-      }
-    }
-  }
-  return 0;
+  size_t pos = isEmpty(subStr) ? std::wstring::npos : str.find(subStr);
+  found = pos != std::wstring::npos;
+  return found ? pos : 0;
 }
 size_t strLength(const wchar_t *str) {
   size_t i = 0;
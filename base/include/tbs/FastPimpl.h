@@ -0,0 +1,191 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_FASTPIMPL_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_FASTPIMPL_H
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <tbs/defs.h>
+
+/**
+ * @brief 模板类 FastPimpl 是 PointerImpl 的内联存储版本。
+ *
+ * 实现类对象直接构造在本对象内部按 Align 对齐的缓冲区中，既保留了 pimpl 的 ABI 隔离，
+ * 又省去了堆分配与指针跳转；getImpl() 不再做空指针检查。
+ *
+ * 缓冲区大小在编译期校验，校验发生在构造与析构函数中，因此使用者必须在实现类完整定义可见的
+ * 源文件中定义自己的构造函数与析构函数（头文件中只做声明）。
+ *
+ * @note 实现类对象随所有者一起被移动，若实现类的地址被其他线程持有（如工作线程、等待者），
+ * 请继续使用 PointerImpl。
+ *
+ * @tparam IMPL 实际实现的类类型。
+ * @tparam Size 内联缓冲区大小（字节），必须不小于 sizeof(IMPL)。
+ * @tparam Align 内联缓冲区对齐，必须是 alignof(IMPL) 的整数倍。
+ */
+template <typename IMPL, size_t Size, size_t Align = alignof(std::max_align_t)>
+class FastPimpl
+{
+private:
+    alignas(Align) std::byte m_storage[Size];
+
+    /**
+     * @brief 在编译期校验缓冲区能否容纳实现类，仅在实现类完整时调用。
+     */
+    static constexpr void validate()
+    {
+        static_assert(sizeof(IMPL) <= Size, "FastPimpl: Size is too small for IMPL, enlarge the buffer");
+        static_assert(Align % alignof(IMPL) == 0, "FastPimpl: Align is not compatible with IMPL");
+    }
+
+    IMPL* pointer() noexcept
+    {
+        return std::launder(reinterpret_cast<IMPL*>(m_storage));
+    }
+
+    const IMPL* pointer() const noexcept
+    {
+        return std::launder(reinterpret_cast<const IMPL*>(m_storage));
+    }
+
+protected:
+    /**
+     * @brief 获取实现类的常引用。
+     *
+     * @return 实现类的常引用。
+     */
+    const IMPL& getImpl() const noexcept
+    {
+        return *pointer();
+    }
+
+    /**
+     * @brief 获取实现类的引用。
+     *
+     * @return 实现类的引用。
+     */
+    IMPL& getImpl() noexcept
+    {
+        return *pointer();
+    }
+
+public:
+    /**
+     * @brief 模板构造函数，在内联缓冲区中构造实现类对象。
+     *
+     * @tparam _Args 构造函数参数类型。
+     * @param args 构造函数参数。
+     */
+    template <typename... _Args>
+        requires(!(sizeof...(_Args) == 1 && (std::is_same_v<std::remove_cvref_t<_Args>, FastPimpl> && ...)))
+    explicit FastPimpl(_Args&&... args)
+    {
+        validate();
+        ::new (static_cast<void*>(m_storage)) IMPL(std::forward<_Args>(args)...);
+    }
+
+    /**
+     * @brief 拷贝构造函数，要求实现类可拷贝构造。
+     *
+     * @param other 要复制的 FastPimpl 对象。
+     */
+    FastPimpl(const FastPimpl& other)
+    {
+        validate();
+        static_assert(std::is_copy_constructible_v<IMPL>, "FastPimpl::FastPimpl: IMPL is not copy constructible");
+        ::new (static_cast<void*>(m_storage)) IMPL(other.getImpl());
+    }
+
+    /**
+     * @brief 移动构造函数，要求实现类可移动构造。
+     *
+     * @param other 要移动的 FastPimpl 对象。
+     */
+    FastPimpl(FastPimpl&& other) noexcept(std::is_nothrow_move_constructible_v<IMPL>)
+    {
+        validate();
+        static_assert(std::is_move_constructible_v<IMPL>, "FastPimpl::FastPimpl: IMPL is not move constructible");
+        ::new (static_cast<void*>(m_storage)) IMPL(std::move(other.getImpl()));
+    }
+
+    /**
+     * @brief 拷贝赋值操作符。
+     *
+     * @param other 要复制的 FastPimpl 对象。
+     * @return 返回当前对象的引用。
+     */
+    FastPimpl& operator=(const FastPimpl& other)
+    {
+        copyFrom(other);
+        return *this;
+    }
+
+    /**
+     * @brief 移动赋值操作符。
+     *
+     * @param other 要移动的 FastPimpl 对象。
+     * @return 返回当前对象的引用。
+     */
+    FastPimpl& operator=(FastPimpl&& other) noexcept(std::is_nothrow_move_assignable_v<IMPL>)
+    {
+        moveFrom(std::move(other));
+        return *this;
+    }
+
+    /**
+     * @brief 从另一个 FastPimpl 对象复制数据。
+     *
+     * @param other 要复制的 FastPimpl 对象。
+     */
+    void copyFrom(const FastPimpl& other)
+    {
+        if (&other == this)
+        {
+            return;
+        }
+        if constexpr (std::is_copy_assignable_v<IMPL>)
+        {
+            getImpl() = other.getImpl();
+        }
+        else if constexpr (std::is_copy_constructible_v<IMPL>)
+        {
+            getImpl().~IMPL();
+            ::new (static_cast<void*>(m_storage)) IMPL(other.getImpl());
+        }
+        else
+        {
+            throw std::runtime_error("FastPimpl::FastPimpl: cannot copy from other pointer");
+        }
+    }
+
+    /**
+     * @brief 从另一个 FastPimpl 对象移动数据。
+     *
+     * @param other 要移动的 FastPimpl 对象。
+     */
+    void moveFrom(FastPimpl&& other) noexcept(std::is_nothrow_move_assignable_v<IMPL>)
+    {
+        static_assert(std::is_move_assignable_v<IMPL>, "FastPimpl::moveFrom: IMPL is not move assignable");
+        if (&other == this)
+        {
+            return;
+        }
+        getImpl() = std::move(other.getImpl());
+    }
+
+    /**
+     * @brief 析构函数，就地析构实现类对象。
+     */
+    virtual ~FastPimpl()
+    {
+        validate();
+        getImpl().~IMPL();
+    }
+};
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_FASTPIMPL_H
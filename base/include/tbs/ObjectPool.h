@@ -0,0 +1,267 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_OBJECTPOOL_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_OBJECTPOOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <tbs/defs.h>
+
+/**
+ * @brief 带线程本地缓存的类型化对象池。
+ *
+ * 每个线程持有一个最多 CacheSize 个空闲槽位的本地链表，获取与归还在本线程内完成时无需加锁；
+ * 本地缓存溢出或耗尽时，与全局仓库批量交换一半槽位。线程退出时其本地缓存归还到全局仓库。
+ *
+ * 槽位内存与 new T 的分配方式完全一致（::operator new(sizeof(T))），因此池中取出的对象可以用
+ * delete 释放，new 出来的对象也可以归还到池中。
+ *
+ * @tparam T 池化对象的类型。
+ * @tparam CacheSize 每个线程本地缓存的最大槽位数。
+ */
+template <typename T, size_t CacheSize = 32>
+class ThreadCachingObjectPool
+{
+private:
+    static_assert(CacheSize >= 2, "ThreadCachingObjectPool: CacheSize must be at least 2");
+
+    /**
+     * @brief 空闲槽位链表节点，直接复用对象的存储空间。
+     */
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    /**
+     * @brief 全局仓库的最大槽位数，超过的部分直接归还给全局分配器。
+     */
+    constexpr static size_t DEPOT_CAPACITY = CacheSize * 8;
+
+    /**
+     * @brief 全局仓库，线程本地缓存之间通过它交换槽位。
+     */
+    struct Depot
+    {
+        std::mutex mutex;
+        FreeNode* head = nullptr;
+        size_t count = 0;
+    };
+
+    /**
+     * @brief 线程本地缓存，线程退出时把槽位归还给全局仓库。
+     */
+    struct LocalCache
+    {
+        FreeNode* head = nullptr;
+        size_t count = 0;
+
+        ~LocalCache()
+        {
+            cacheDestroyed() = true;
+            giveBack(*this, count);
+        }
+    };
+
+    /**
+     * @brief 全局仓库实例。
+     *
+     * 故意不析构：分离的工作线程可能在静态对象析构之后才退出并归还槽位。
+     */
+    static Depot& depot()
+    {
+        static Depot* d = new Depot();
+        return *d;
+    }
+
+    static LocalCache& local()
+    {
+        thread_local LocalCache cache;
+        return cache;
+    }
+
+    /**
+     * @brief 当前线程的本地缓存是否已析构，析构后的获取与归还直接走全局仓库。
+     */
+    static bool& cacheDestroyed()
+    {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    static FreeNode* popFrom(FreeNode*& head, size_t& count)
+    {
+        FreeNode* n = head;
+        head = n->next;
+        --count;
+        return n;
+    }
+
+    static void pushTo(FreeNode*& head, size_t& count, void* p)
+    {
+        auto* n = static_cast<FreeNode*>(p);
+        n->next = head;
+        head = n;
+        ++count;
+    }
+
+    /**
+     * @brief 从全局仓库批量取回 n 个槽位到本地缓存。
+     */
+    static void takeFrom(LocalCache& c, size_t n)
+    {
+        Depot& d = depot();
+        std::lock_guard<std::mutex> g(d.mutex);
+        while (n-- > 0 && d.head != nullptr)
+        {
+            pushTo(c.head, c.count, popFrom(d.head, d.count));
+        }
+    }
+
+    /**
+     * @brief 把本地缓存中的 n 个槽位归还给全局仓库，仓库已满的部分直接释放。
+     */
+    static void giveBack(LocalCache& c, size_t n)
+    {
+        FreeNode* overflow = nullptr;
+        size_t overflowCount = 0;
+        {
+            Depot& d = depot();
+            std::lock_guard<std::mutex> g(d.mutex);
+            while (n-- > 0 && c.head != nullptr)
+            {
+                FreeNode* node = popFrom(c.head, c.count);
+                if (d.count < DEPOT_CAPACITY)
+                {
+                    pushTo(d.head, d.count, node);
+                }
+                else
+                {
+                    pushTo(overflow, overflowCount, node);
+                }
+            }
+        }
+        while (overflow != nullptr)
+        {
+            ::operator delete(popFrom(overflow, overflowCount));
+        }
+    }
+
+    static void* allocate()
+    {
+        if (!cacheDestroyed())
+        {
+            LocalCache& c = local();
+            if (c.head == nullptr)
+            {
+                takeFrom(c, CacheSize / 2);
+            }
+            if (c.head != nullptr)
+            {
+                return popFrom(c.head, c.count);
+            }
+        }
+        return ::operator new(sizeof(T));
+    }
+
+    static void deallocate(void* p)
+    {
+        if (cacheDestroyed())
+        {
+            ::operator delete(p);
+            return;
+        }
+        LocalCache& c = local();
+        pushTo(c.head, c.count, p);
+        if (c.count > CacheSize)
+        {
+            giveBack(c, CacheSize / 2);
+        }
+    }
+
+public:
+    static_assert(sizeof(T) >= sizeof(FreeNode), "ThreadCachingObjectPool: T is too small to be pooled");
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "ThreadCachingObjectPool: over-aligned T is not supported");
+
+    /**
+     * @brief 从池中取出一个槽位并构造对象。
+     *
+     * @tparam _Args 构造函数参数类型。
+     * @param args 构造函数参数。
+     * @return 新构造对象的指针。
+     */
+    template <typename... _Args>
+    static T* acquire(_Args&&... args)
+    {
+        void* p = allocate();
+        try
+        {
+            return ::new (p) T(std::forward<_Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    /**
+     * @brief 析构对象并把槽位归还到池中。
+     *
+     * @param p 要归还的对象指针，可以为 nullptr。
+     */
+    static void release(T* p)
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+        p->~T();
+        deallocate(p);
+    }
+
+    /**
+     * @brief 把当前线程的缓存与全局仓库中的空闲槽位全部归还给全局分配器。
+     */
+    static void trim()
+    {
+        FreeNode* head = nullptr;
+        size_t count = 0;
+        if (!cacheDestroyed())
+        {
+            LocalCache& c = local();
+            head = c.head;
+            count = c.count;
+            c.head = nullptr;
+            c.count = 0;
+        }
+        {
+            Depot& d = depot();
+            std::lock_guard<std::mutex> g(d.mutex);
+            while (d.head != nullptr)
+            {
+                pushTo(head, count, popFrom(d.head, d.count));
+            }
+        }
+        while (head != nullptr)
+        {
+            ::operator delete(popFrom(head, count));
+        }
+    }
+
+    /**
+     * @brief 获取当前线程本地缓存中的空闲槽位数。
+     *
+     * @return 空闲槽位数。
+     */
+    static size_t localCachedCount()
+    {
+        return cacheDestroyed() ? 0 : local().count;
+    }
+};
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_OBJECTPOOL_H
@@ -5,10 +5,14 @@
 #ifndef TBS_TOOL_LIB_OPTION_H
 #define TBS_TOOL_LIB_OPTION_H
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <type_traits>
 #include <vector>
 #include "defs.h"
 #include "option/NullOption.h"
+#include "option/RefOption.h"
 /**
  * @class OptionFactory
  *
@@ -24,6 +28,7 @@ class OptionFactory;
  * @brief 模板类，表示一个可选值（Optional Value）。
  *
  * 该类可以包含一个值或为空（null）。它提供了检查是否包含值的方法以及访问内部值的方法。
+ * 值直接存放在对象内部，不产生堆分配；map/and_then/or_else 等组合子在右值上调用时会移动内部值。
  *
  * @tparam T 类型参数，表示 Option 可以持有的值的类型。
  */
@@ -40,7 +45,7 @@ public:
      */
     [[nodiscard]] bool isNull() const
     {
-        return m_val == nullptr;
+        return !m_val.has_value();
     }
 
     /**
@@ -48,7 +53,7 @@ public:
      *
      * @return 返回内部值的引用。
      */
-    T& operator*()
+    T& operator*() &
     {
         return *m_val;
     }
@@ -58,11 +63,21 @@ public:
      *
      * @return 返回内部值的常量引用。
      */
-    const T& operator*() const
+    const T& operator*() const&
     {
         return *m_val;
     }
 
+    /**
+     * @brief 解引用 Option 以获取内部值（右值版本）。
+     *
+     * @return 返回内部值的右值引用，便于移动。
+     */
+    T&& operator*() &&
+    {
+        return std::move(*m_val);
+    }
+
     /**
      * @brief 获取指向内部值的指针。
      *
@@ -70,7 +85,7 @@ public:
      */
     T* operator->()
     {
-        return m_val.get();
+        return &*m_val;
     }
 
     /**
@@ -80,7 +95,7 @@ public:
      */
     const T* operator->() const
     {
-        return m_val.get();
+        return &*m_val;
     }
 
     /**
@@ -118,7 +133,7 @@ public:
     {
         if (!this->isNull() && !other.isNull())
         {
-            return *m_val != *other.m_val;
+            return *m_val != *other;
         }
         return this->isNull() != other.isNull();
     }
@@ -162,7 +177,7 @@ public:
     /**
      * @brief 默认构造函数，初始化为空。
      */
-    Option() : m_val(nullptr)
+    Option() : m_val(std::nullopt)
     {
     }
 
@@ -171,7 +186,7 @@ public:
      *
      * @param val 要存储的值。
      */
-    explicit Option(T&& val) : m_val(new T(std::move(val)))
+    explicit Option(T&& val) : m_val(std::move(val))
     {
     }
 
@@ -180,7 +195,7 @@ public:
      *
      * @param val 要存储的值。
      */
-    explicit Option(const T& val) : m_val(new T(val))
+    explicit Option(const T& val) : m_val(val)
     {
     }
 
@@ -192,7 +207,7 @@ public:
      */
     Option<T>& operator<<(T&& val)
     {
-        m_val.reset(new T(std::move(val)));
+        m_val.emplace(std::move(val));
         return *this;
     }
 
@@ -203,10 +218,221 @@ public:
      */
     Option<T>& operator<<(const T& val)
     {
-        m_val.reset(new T(val));
+        m_val.emplace(val);
+        return *this;
+    }
+
+    /**
+     * @brief 对内部值应用函数，返回包含结果的新 Option；为空时返回空 Option。
+     *
+     * 函数返回左值引用时结果为 Option<U&>，否则为 Option<U>。
+     *
+     * @tparam F 函数类型，签名为 U(T&)。
+     * @param f 要应用的函数。
+     * @return 包含函数结果的 Option。
+     */
+    template <typename F>
+    auto map(F&& f) &
+    {
+        return mapImpl(*this, std::forward<F>(f));
+    }
+
+    /**
+     * @brief 对内部值应用函数（常量版本）。
+     *
+     * @tparam F 函数类型，签名为 U(const T&)。
+     * @param f 要应用的函数。
+     * @return 包含函数结果的 Option。
+     */
+    template <typename F>
+    auto map(F&& f) const&
+    {
+        return mapImpl(*this, std::forward<F>(f));
+    }
+
+    /**
+     * @brief 对内部值应用函数（右值版本），内部值以右值传给函数，不产生拷贝。
+     *
+     * @tparam F 函数类型，签名为 U(T&&)。
+     * @param f 要应用的函数。
+     * @return 包含函数结果的 Option。
+     */
+    template <typename F>
+    auto map(F&& f) &&
+    {
+        return mapImpl(std::move(*this), std::forward<F>(f));
+    }
+
+    /**
+     * @brief 对内部值应用返回 Option 的函数，并直接返回该结果；为空时返回空 Option。
+     *
+     * @tparam F 函数类型，签名为 Option<U>(T&)。
+     * @param f 要应用的函数。
+     * @return 函数返回的 Option。
+     */
+    template <typename F>
+    auto and_then(F&& f) &
+    {
+        return andThenImpl(*this, std::forward<F>(f));
+    }
+
+    /**
+     * @brief 对内部值应用返回 Option 的函数（常量版本）。
+     *
+     * @tparam F 函数类型，签名为 Option<U>(const T&)。
+     * @param f 要应用的函数。
+     * @return 函数返回的 Option。
+     */
+    template <typename F>
+    auto and_then(F&& f) const&
+    {
+        return andThenImpl(*this, std::forward<F>(f));
+    }
+
+    /**
+     * @brief 对内部值应用返回 Option 的函数（右值版本）。
+     *
+     * @tparam F 函数类型，签名为 Option<U>(T&&)。
+     * @param f 要应用的函数。
+     * @return 函数返回的 Option。
+     */
+    template <typename F>
+    auto and_then(F&& f) &&
+    {
+        return andThenImpl(std::move(*this), std::forward<F>(f));
+    }
+
+    /**
+     * @brief 不为空时返回自身的拷贝，为空时返回函数生成的 Option。
+     *
+     * @tparam F 函数类型，签名为 Option<T>()。
+     * @param f 为空时调用的函数。
+     * @return 自身或函数生成的 Option。
+     */
+    template <typename F>
+    Option<T> or_else(F&& f) const&
+    {
+        static_assert(std::is_same_v<std::remove_cvref_t<std::invoke_result_t<F>>, Option<T>>, "Option::or_else: function must return Option<T>");
+        if (!isNull())
+        {
+            return *this;
+        }
+        return std::invoke(std::forward<F>(f));
+    }
+
+    /**
+     * @brief 不为空时移动返回自身，为空时返回函数生成的 Option（右值版本）。
+     *
+     * @tparam F 函数类型，签名为 Option<T>()。
+     * @param f 为空时调用的函数。
+     * @return 自身或函数生成的 Option。
+     */
+    template <typename F>
+    Option<T> or_else(F&& f) &&
+    {
+        static_assert(std::is_same_v<std::remove_cvref_t<std::invoke_result_t<F>>, Option<T>>, "Option::or_else: function must return Option<T>");
+        if (!isNull())
+        {
+            return std::move(*this);
+        }
+        return std::invoke(std::forward<F>(f));
+    }
+
+    /**
+     * @brief 获取内部值，为空时返回默认值。
+     *
+     * @tparam U 默认值类型，必须可以转换为 T。
+     * @param defaultValue 默认值。
+     * @return 内部值的拷贝或默认值。
+     */
+    template <typename U>
+    T value_or(U&& defaultValue) const&
+    {
+        return isNull() ? static_cast<T>(std::forward<U>(defaultValue)) : *m_val;
+    }
+
+    /**
+     * @brief 获取内部值，为空时返回默认值（右值版本，内部值被移动出来）。
+     *
+     * @tparam U 默认值类型，必须可以转换为 T。
+     * @param defaultValue 默认值。
+     * @return 内部值或默认值。
+     */
+    template <typename U>
+    T value_or(U&& defaultValue) &&
+    {
+        return isNull() ? static_cast<T>(std::forward<U>(defaultValue)) : std::move(*m_val);
+    }
+
+    /**
+     * @brief 就地变换内部值，为空时不做任何操作。
+     *
+     * 与 map 不同，transform 不会创建新的 Option，而是直接修改当前持有的值。
+     *
+     * @tparam F 函数类型，签名为 void(T&)。
+     * @param f 要应用的函数。
+     * @return 返回当前 Option 对象的引用，便于链式调用。
+     */
+    template <typename F>
+    Option<T>& transform(F&& f) &
+    {
+        if (!isNull())
+        {
+            std::invoke(std::forward<F>(f), *m_val);
+        }
         return *this;
     }
 
+    /**
+     * @brief 就地变换内部值（右值版本）。
+     *
+     * @tparam F 函数类型，签名为 void(T&)。
+     * @param f 要应用的函数。
+     * @return 变换后的 Option，按值返回，用于临时对象时不会悬垂。
+     */
+    template <typename F>
+    Option<T> transform(F&& f) &&
+    {
+        if (!isNull())
+        {
+            std::invoke(std::forward<F>(f), *m_val);
+        }
+        return std::move(*this);
+    }
+
+private:
+    /**
+     * @brief map 的公共实现，根据 self 的值类别转发内部值。
+     */
+    template <typename Self, typename F>
+    static auto mapImpl(Self&& self, F&& f)
+    {
+        using __value_ref = decltype(*std::forward<Self>(self));
+        using __result = std::invoke_result_t<F, __value_ref>;
+        static_assert(!std::is_void_v<__result>, "Option::map: function must return a value, use transform instead");
+        using __mapped = std::conditional_t<std::is_lvalue_reference_v<__result>, __result, std::remove_cvref_t<__result>>;
+        if (self.isNull())
+        {
+            return Option<__mapped>();
+        }
+        return Option<__mapped>(std::invoke(std::forward<F>(f), *std::forward<Self>(self)));
+    }
+
+    /**
+     * @brief and_then 的公共实现，根据 self 的值类别转发内部值。
+     */
+    template <typename Self, typename F>
+    static auto andThenImpl(Self&& self, F&& f)
+    {
+        using __value_ref = decltype(*std::forward<Self>(self));
+        using __result = std::remove_cvref_t<std::invoke_result_t<F, __value_ref>>;
+        if (self.isNull())
+        {
+            return __result();
+        }
+        return std::invoke(std::forward<F>(f), *std::forward<Self>(self));
+    }
+
 private:
     /**
      * @brief OptionFactory 是 Option 的友元类。
@@ -214,9 +440,9 @@ private:
     friend class OptionFactory;
 
     /**
-     * @brief 存储实际值的智能指针。
+     * @brief 内联存储的实际值。
      */
-    std::unique_ptr<T> m_val;
+    std::optional<T> m_val;
 };
 
 
@@ -236,9 +462,9 @@ public:
      * @return 返回新的 Option 对象。
      */
     template <typename T>
-    static Option<T> of(T&& val)
+    static Option<std::remove_cvref_t<T>> of(T&& val)
     {
-        return Option<T>(std::forward<T>(val));
+        return Option<std::remove_cvref_t<T>>(std::forward<T>(val));
     }
 
     /**
@@ -264,6 +490,19 @@ public:
         return {};
     }
 
+    /**
+     * @brief 创建一个引用外部对象的 Option 对象，不拷贝值。
+     *
+     * @tparam T 被引用对象的类型。
+     * @param val 被引用的对象，其生命周期必须长于返回的 Option。
+     * @return 返回引用 val 的 Option 对象。
+     */
+    template <typename T>
+    static Option<T&> ref(T& val)
+    {
+        return Option<T&>(val);
+    }
+
     /**
      * @brief 创建一个新的 Option 对象，通过字符串初始化。
      *
@@ -361,4 +600,13 @@ public:
  */
 #define NONE_OPTION OptionFactory::nullOf()
 
+/**
+ * @def REF_OPTION(val)
+ *
+ * @brief 宏定义，用于创建一个引用 val 的 Option 对象。
+ *
+ * @param val 被引用的对象。
+ */
+#define REF_OPTION(val) OptionFactory::ref(val)
+
 #endif // TBS_TOOL_LIB_OPTION_H
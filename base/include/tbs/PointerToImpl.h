@@ -1,6 +1,7 @@
 #ifndef POINTERTOIMPL_H
 #define POINTERTOIMPL_H
 #include <memory>
+#include <tbs/ObjectPool.h>
 #include <tbs/defs.h>
 
 /**
@@ -60,6 +61,43 @@ T* empty_args_remake()
     return new T();
 }
 
+/**
+ * @brief 池化的重置函数，析构对象并把内存归还到线程缓存对象池。
+ *
+ * @tparam T 实现类的类型。
+ * @param ptr 需要重置的指针。
+ */
+template <typename T>
+void pooled_resetor(T*& ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    ThreadCachingObjectPool<T>::release(ptr);
+    ptr = nullptr;
+}
+
+/**
+ * @brief 池化的重新创建函数，从线程缓存对象池中取出内存并默认构造对象。
+ *
+ * @tparam T 实现类的类型。
+ * @return 返回新创建的实现类对象的指针。
+ * @throws std::runtime_error 实现类不可默认构造时抛出运行时错误。
+ */
+template <typename T>
+T* pooled_remake()
+{
+    if constexpr (std::is_default_constructible_v<T>)
+    {
+        return ThreadCachingObjectPool<T>::acquire();
+    }
+    else
+    {
+        return no_remake<T>();
+    }
+}
+
 /**
  * @brief 模板类 PointerImpl 实现了指向实现的指针，用于封装实际的实现细节。
  *
@@ -236,4 +274,21 @@ public:
     }
 };
 
+/**
+ * @brief 使用线程缓存对象池管理实现类内存的 PointerImpl。
+ *
+ * 实现类通过 ThreadCachingObjectPool<IMPL>::acquire 创建后传入构造函数，析构时内存回到池中，
+ * 频繁创建销毁的短生命周期对象不再访问全局分配器。
+ * 由于池中内存与 new IMPL 兼容，模板构造函数与 copyFrom 中的 new IMPL 同样可以安全归还到池中。
+ *
+ * @note 重置函数需要完整的实现类，若实现类仅在源文件中可见，应在头文件中声明
+ * extern template 并在源文件中显式实例化 pooled_resetor / pooled_remake。
+ * @note pooled_remake 只做默认构造；构造后还需初始化的实现类应改用 no_remake，
+ * 即 PointerImpl<IMPL, pooled_resetor<IMPL>, no_remake<IMPL>>。
+ *
+ * @tparam IMPL 实际实现的类类型。
+ */
+template <typename IMPL>
+using PooledPointerImpl = PointerImpl<IMPL, pooled_resetor<IMPL>, pooled_remake<IMPL>>;
+
 #endif // POINTERTOIMPL_H
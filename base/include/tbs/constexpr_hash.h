@@ -0,0 +1,487 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef CONSTEXPR_HASH_H
+#define CONSTEXPR_HASH_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "constexpr_value.h"
+#include "defs.h"
+
+/**
+ * @brief 编译期可用的 32 位 FNV-1a 哈希
+ *
+ * @param str 要哈希的字符串
+ * @return 哈希值
+ */
+constexpr uint32_t fnv1a32(std::string_view str)
+{
+    uint32_t h = 2166136261u;
+    for (char c : str)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief 编译期可用的 64 位 FNV-1a 哈希
+ *
+ * @param str 要哈希的字符串
+ * @return 哈希值
+ */
+constexpr uint64_t fnv1a64(std::string_view str)
+{
+    uint64_t h = 14695981039346656037ull;
+    for (char c : str)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+namespace tbs::__hash_detail
+{
+    constexpr uint64_t P1 = 11400714785074694791ull;
+    constexpr uint64_t P2 = 14029467366897019727ull;
+    constexpr uint64_t P3 = 1609587929392839161ull;
+    constexpr uint64_t P4 = 9650029242287828579ull;
+    constexpr uint64_t P5 = 2870177450012600261ull;
+
+    constexpr uint64_t read64(std::string_view s, size_t i)
+    {
+        uint64_t r = 0;
+        for (size_t k = 0; k < 8; k++)
+        {
+            r |= static_cast<uint64_t>(static_cast<unsigned char>(s[i + k])) << (8 * k);
+        }
+        return r;
+    }
+
+    constexpr uint64_t read32(std::string_view s, size_t i)
+    {
+        uint64_t r = 0;
+        for (size_t k = 0; k < 4; k++)
+        {
+            r |= static_cast<uint64_t>(static_cast<unsigned char>(s[i + k])) << (8 * k);
+        }
+        return r;
+    }
+
+    constexpr uint64_t round(uint64_t acc, uint64_t input)
+    {
+        acc += input * P2;
+        acc = std::rotl(acc, 31);
+        return acc * P1;
+    }
+
+    constexpr uint64_t mergeRound(uint64_t acc, uint64_t val)
+    {
+        acc ^= round(0, val);
+        return acc * P1 + P4;
+    }
+} // namespace tbs::__hash_detail
+
+/**
+ * @brief 编译期可用的 XXH64 哈希，结果与官方 xxHash 的 XXH64 一致
+ *
+ * 编译期按字节小端拼装读取，运行时编译器会把它优化为普通的 64 位读取。
+ *
+ * @param str 要哈希的字符串
+ * @param seed 种子
+ * @return 哈希值
+ */
+constexpr uint64_t xxHash64(std::string_view str, uint64_t seed = 0)
+{
+    using namespace tbs::__hash_detail;
+    const size_t len = str.size();
+    size_t i = 0;
+    uint64_t h;
+    if (len >= 32)
+    {
+        uint64_t v1 = seed + P1 + P2;
+        uint64_t v2 = seed + P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - P1;
+        for (; i + 32 <= len; i += 32)
+        {
+            v1 = round(v1, read64(str, i));
+            v2 = round(v2, read64(str, i + 8));
+            v3 = round(v3, read64(str, i + 16));
+            v4 = round(v4, read64(str, i + 24));
+        }
+        h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        h = mergeRound(h, v1);
+        h = mergeRound(h, v2);
+        h = mergeRound(h, v3);
+        h = mergeRound(h, v4);
+    }
+    else
+    {
+        h = seed + P5;
+    }
+    h += len;
+    for (; i + 8 <= len; i += 8)
+    {
+        h ^= round(0, read64(str, i));
+        h = std::rotl(h, 27) * P1 + P4;
+    }
+    if (i + 4 <= len)
+    {
+        h ^= read32(str, i) * P1;
+        h = std::rotl(h, 23) * P2 + P3;
+        i += 4;
+    }
+    for (; i < len; i++)
+    {
+        h ^= static_cast<unsigned char>(str[i]) * P5;
+        h = std::rotl(h, 11) * P1;
+    }
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+/**
+ * @brief 对常量字符串计算 FNV-1a 哈希
+ *
+ * @tparam N 常量字符串的容量
+ * @param str 常量字符串
+ * @return 哈希值
+ */
+template <size_t N>
+constexpr uint64_t fnv1a64(CONST ConstexprValue<char, N>& str)
+{
+    return fnv1a64(str.to_string_view());
+}
+
+/**
+ * @brief 对常量字符串计算 XXH64 哈希
+ *
+ * @tparam N 常量字符串的容量
+ * @param str 常量字符串
+ * @param seed 种子
+ * @return 哈希值
+ */
+template <size_t N>
+constexpr uint64_t xxHash64(CONST ConstexprValue<char, N>& str, uint64_t seed = 0)
+{
+    return xxHash64(str.to_string_view(), seed);
+}
+
+/**
+ * @brief 64 位整数的混淆函数（splitmix64 的终结步骤），用于整数键的哈希
+ *
+ * @param x 输入
+ * @return 混淆后的值
+ */
+constexpr uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief 对整数元素的 ConstexprValue 计算哈希
+ *
+ * @tparam T 整数类型
+ * @tparam N 元素个数
+ * @param v 常量值
+ * @param seed 种子
+ * @return 哈希值
+ */
+template <typename T, size_t N>
+    requires std::is_integral_v<T> && (!std::is_same_v<T, char>)
+constexpr uint64_t xxHash64(CONST ConstexprValue<T, N>& v, uint64_t seed = 0)
+{
+    uint64_t h = mix64(seed + N);
+    if constexpr (N == 1)
+    {
+        h = mix64(h ^ static_cast<uint64_t>(v.get()));
+    }
+    else
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            h = mix64(h ^ static_cast<uint64_t>(v.get(i)));
+        }
+    }
+    return h;
+}
+
+/**
+ * @brief 字符串字面量的编译期哈希，例如 switch (xxHash64(cmd)) { case "get"_hash: ... }
+ */
+consteval uint64_t operator""_hash(const char* str, size_t len)
+{
+    return xxHash64(std::string_view(str, len));
+}
+
+template <size_t N>
+struct std::hash<ConstexprValue<char, N>>
+{
+    constexpr size_t operator()(const ConstexprValue<char, N>& v) const noexcept
+    {
+        return static_cast<size_t>(xxHash64(v.to_string_view()));
+    }
+};
+
+/**
+ * @brief 编译期哈希函数，字符串类键使用 XXH64，整数与枚举键使用 mix64
+ *
+ * @tparam Key 键类型
+ */
+template <typename Key>
+struct ConstexprHasher
+{
+    constexpr uint64_t operator()(const Key& key, uint64_t seed) const
+    {
+        if constexpr (std::is_convertible_v<const Key&, std::string_view>)
+        {
+            return xxHash64(std::string_view(key), seed);
+        }
+        else
+        {
+            static_assert(std::is_integral_v<Key> || std::is_enum_v<Key>, "ConstexprHasher: unsupported key type");
+            return mix64(static_cast<uint64_t>(key) ^ mix64(seed));
+        }
+    }
+};
+
+/**
+ * @brief 编译期构建的完美哈希表，适合固定的关键字表（如协议命令分发）
+ *
+ * 采用 hash-and-displace：键先按种子 0 的哈希分到 N 个桶中，从大桶开始为每个桶寻找一个位移种子，
+ * 使桶内所有键在槽位表中互不冲突且不与已放置的键冲突。查找时只需两次哈希、一次读取位移与一次键比较，
+ * 没有探测循环。槽位表大小为 2 * bit_ceil(N)，构造在编译期完成，重复的键会导致编译失败。
+ *
+ * @tparam Key 键类型，std::string_view 或整数 / 枚举
+ * @tparam Value 值类型
+ * @tparam N 键值对个数
+ */
+template <typename Key, typename Value, size_t N>
+class ConstexprPerfectHashMap
+{
+public:
+    using value_type = std::pair<Key, Value>;
+
+    /**
+     * @brief 从键值对数组构造
+     *
+     * @param entries 键值对数组
+     */
+    constexpr explicit ConstexprPerfectHashMap(CONST std::array<value_type, N>& entries) : m_entries(entries)
+    {
+        build();
+    }
+
+    /**
+     * @brief 查找键对应的值
+     *
+     * @param key 键
+     * @return 值的指针，不存在时返回 nullptr
+     */
+    constexpr CONST Value* find(CONST Key& key) const
+    {
+        if constexpr (N == 0)
+        {
+            return nullptr;
+        }
+        else
+        {
+            uint32_t idx = m_slots[slotOf(key)];
+            if (idx != EMPTY && m_entries[idx].first == key)
+            {
+                return &m_entries[idx].second;
+            }
+            return nullptr;
+        }
+    }
+
+    /**
+     * @brief 判断键是否存在
+     *
+     * @param key 键
+     * @return 存在返回 true，否则返回 false
+     */
+    constexpr bool contains(CONST Key& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief 获取键对应的值
+     *
+     * @param key 键
+     * @return 值的常量引用
+     * @throws tbs::base_error 键不存在时抛出
+     */
+    constexpr CONST Value& at(CONST Key& key) const
+    {
+        CONST Value* v = find(key);
+        if (v == nullptr)
+        {
+            throw tbs::base_error("ConstexprPerfectHashMap: key not found");
+        }
+        return *v;
+    }
+
+    /**
+     * @brief 获取键值对个数
+     *
+     * @return 键值对个数
+     */
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return N;
+    }
+
+    constexpr auto begin() const
+    {
+        return m_entries.begin();
+    }
+
+    constexpr auto end() const
+    {
+        return m_entries.end();
+    }
+
+private:
+    constexpr static size_t BUCKETS = N > 0 ? N : 1;
+    constexpr static size_t TABLE_SIZE = std::bit_ceil(BUCKETS) * 2;
+    constexpr static uint32_t EMPTY = UINT32_MAX;
+
+    /**
+     * @brief 为一个桶寻找位移种子的最大尝试次数，超过后构造失败（编译错误）
+     */
+    constexpr static uint32_t MAX_ATTEMPTS = 1u << 16;
+
+    constexpr size_t bucketOf(CONST Key& key) const
+    {
+        return ConstexprHasher<Key>{}(key, 0) % BUCKETS;
+    }
+
+    constexpr size_t slotOf(CONST Key& key) const
+    {
+        return ConstexprHasher<Key>{}(key, m_displacements[bucketOf(key)]) & (TABLE_SIZE - 1);
+    }
+
+    constexpr void build()
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            for (size_t j = i + 1; j < N; j++)
+            {
+                if (m_entries[i].first == m_entries[j].first)
+                {
+                    throw tbs::base_error("ConstexprPerfectHashMap: duplicate key");
+                }
+            }
+        }
+        m_slots.fill(EMPTY);
+        std::array<size_t, BUCKETS> counts{};
+        std::array<size_t, N> buckets{};
+        size_t largest = 0;
+        for (size_t i = 0; i < N; i++)
+        {
+            buckets[i] = bucketOf(m_entries[i].first);
+            largest = std::max(largest, ++counts[buckets[i]]);
+        }
+        // 从大桶到小桶依次放置，大桶约束最多，越早放置越容易找到位移
+        for (size_t size = largest; size > 0; size--)
+        {
+            for (size_t b = 0; b < BUCKETS; b++)
+            {
+                if (counts[b] == size)
+                {
+                    placeBucket(b, buckets);
+                }
+            }
+        }
+    }
+
+    constexpr void placeBucket(size_t bucket, CONST std::array<size_t, N>& buckets)
+    {
+        for (uint32_t seed = 1; seed < MAX_ATTEMPTS; seed++)
+        {
+            std::array<size_t, N> used{};
+            size_t n = 0;
+            bool ok = true;
+            for (size_t i = 0; i < N && ok; i++)
+            {
+                if (buckets[i] != bucket)
+                {
+                    continue;
+                }
+                size_t slot = ConstexprHasher<Key>{}(m_entries[i].first, seed) & (TABLE_SIZE - 1);
+                if (m_slots[slot] != EMPTY)
+                {
+                    ok = false;
+                }
+                for (size_t k = 0; k < n && ok; k++)
+                {
+                    ok = used[k] != slot;
+                }
+                used[n++] = slot;
+            }
+            if (!ok)
+            {
+                continue;
+            }
+            m_displacements[bucket] = seed;
+            n = 0;
+            for (size_t i = 0; i < N; i++)
+            {
+                if (buckets[i] == bucket)
+                {
+                    m_slots[used[n++]] = static_cast<uint32_t>(i);
+                }
+            }
+            return;
+        }
+        throw tbs::base_error("ConstexprPerfectHashMap: failed to find displacement");
+    }
+
+    std::array<value_type, N> m_entries;
+    std::array<uint32_t, TABLE_SIZE> m_slots{};
+    std::array<uint32_t, BUCKETS> m_displacements{};
+};
+
+/**
+ * @brief 从键值对列表构造完美哈希表，例如 makePerfectHashMap<std::string_view, int>({{"get", 1}, {"set", 2}})
+ *
+ * @tparam Key 键类型
+ * @tparam Value 值类型
+ * @tparam N 键值对个数，自动推导
+ * @param entries 键值对列表
+ * @return 完美哈希表
+ */
+template <typename Key, typename Value, size_t N>
+constexpr ConstexprPerfectHashMap<Key, Value, N> makePerfectHashMap(const std::pair<Key, Value> (&entries)[N])
+{
+    std::array<std::pair<Key, Value>, N> arr{};
+    for (size_t i = 0; i < N; i++)
+    {
+        arr[i] = entries[i];
+    }
+    return ConstexprPerfectHashMap<Key, Value, N>(arr);
+}
+
+#endif // CONSTEXPR_HASH_H
@@ -3,6 +3,7 @@
 
 #ifndef CIRCLEQUEUE_H
 #define CIRCLEQUEUE_H
+#include "../Option.h"
 #include "../defs.h"
 #include "iterator/Iteratable.h"
 
@@ -266,6 +267,34 @@ public:
         return m_data[m_head];
     }
 
+    /**
+     * @brief 以引用形式查看队首元素，不抛出异常。
+     *
+     * @return 队首元素的引用，队列为空时返回空 Option。
+     */
+    Option<T&> tryFront()
+    {
+        if (empty())
+        {
+            return Option<T&>();
+        }
+        return Option<T&>(m_data[m_head]);
+    }
+
+    /**
+     * @brief 以常量引用形式查看队首元素，不抛出异常。
+     *
+     * @return 队首元素的常量引用，队列为空时返回空 Option。
+     */
+    Option<CONST T&> tryFront() const
+    {
+        if (empty())
+        {
+            return Option<CONST T&>();
+        }
+        return Option<CONST T&>(m_data[m_head]);
+    }
+
     /**
      * @brief 获取队尾元素的常量引用。
      *
@@ -0,0 +1,192 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_MEMORY_ARENA_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_MEMORY_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <tbs/defs.h>
+
+namespace tbs::memory
+{
+    /**
+     * @brief 线程安全的单调（bump-pointer）内存竞技场。
+     *
+     * 内存按块向上游资源申请，分配时只移动当前块的偏移量（无锁 CAS），块用尽时加锁换块；
+     * 单次释放是空操作，所有内存通过 reset() 一次性回收。
+     * Arena 本身是一个 std::pmr::memory_resource，可直接用于 std::pmr 容器，也可以通过
+     * ArenaAllocator 用于普通的分配器模板参数。
+     *
+     * @note reset() 与 release() 不能与分配并发执行，且调用后所有从本竞技场得到的内存均失效。
+     */
+    class Arena : public std::pmr::memory_resource
+    {
+    public:
+        /**
+         * @brief 默认块大小（字节）。
+         */
+        constexpr static size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+        /**
+         * @brief 构造函数。
+         *
+         * @param chunkSize 每个内存块的大小（字节）。
+         * @param upstream 上游内存资源，块从这里申请。
+         */
+        explicit Arena(size_t chunkSize = DEFAULT_CHUNK_SIZE, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+        DELETE_COPY_CONSTRUCTION(Arena)
+        DELETE_COPY_ASSIGNMENT(Arena)
+
+        /**
+         * @brief 析构函数，把所有块归还给上游资源。
+         */
+        ~Arena() override;
+
+        /**
+         * @brief 批量回收：回卷所有标准块以便复用，释放单独申请的大块。
+         */
+        void reset();
+
+        /**
+         * @brief 把所有块（包括备用块）归还给上游资源。
+         */
+        void release();
+
+        /**
+         * @brief 获取已分配出去的字节数（含对齐填充）。
+         *
+         * @return 已分配字节数。
+         */
+        [[nodiscard]] size_t usedBytes() const;
+
+        /**
+         * @brief 获取当前向上游申请的总容量（字节），包括备用块。
+         *
+         * @return 总容量。
+         */
+        [[nodiscard]] size_t capacity() const;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        struct Chunk;
+
+        Chunk* newChunk(size_t capacity);
+
+        void freeChunks(Chunk*& head);
+
+        size_t m_chunkSize;
+        std::pmr::memory_resource* m_upstream;
+
+        /**
+         * @brief 当前用于 bump 分配的块。
+         */
+        std::atomic<Chunk*> m_current{nullptr};
+
+        /**
+         * @brief 使用中的块链表（标准块与大块）。
+         */
+        Chunk* m_chunks = nullptr;
+
+        /**
+         * @brief reset 之后留待复用的标准块链表。
+         */
+        Chunk* m_spare = nullptr;
+
+        /**
+         * @brief 保护块链表的互斥锁，只在换块时使用。
+         */
+        mutable std::mutex m_mutex;
+    };
+
+    /**
+     * @brief 基于 Arena 的标准分配器，可作为容器的分配器模板参数。
+     *
+     * deallocate 为空操作，内存随 Arena::reset() 统一回收。
+     *
+     * @tparam T 分配的元素类型。
+     */
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        /**
+         * @brief 构造函数。
+         *
+         * @param arena 提供内存的竞技场，其生命周期必须长于使用该分配器的容器。
+         */
+        explicit ArenaAllocator(Arena& arena) noexcept : m_arena(&arena)
+        {
+        }
+
+        /**
+         * @brief 从其他元素类型的分配器重绑定构造。
+         *
+         * @tparam U 其他元素类型。
+         * @param other 其他分配器。
+         */
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.arena())
+        {
+        }
+
+        /**
+         * @brief 分配 n 个元素的内存。
+         *
+         * @param n 元素个数。
+         * @return 内存首地址。
+         */
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        /**
+         * @brief 空操作，内存随竞技场统一回收。
+         */
+        void deallocate(T*, size_t) noexcept
+        {
+        }
+
+        /**
+         * @brief 获取关联的竞技场。
+         *
+         * @return 竞技场指针。
+         */
+        [[nodiscard]] Arena* arena() const noexcept
+        {
+            return m_arena;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept
+        {
+            return m_arena == other.arena();
+        }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const noexcept
+        {
+            return m_arena != other.arena();
+        }
+
+    private:
+        Arena* m_arena;
+    };
+} // namespace tbs::memory
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_MEMORY_ARENA_H
@@ -0,0 +1,246 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_OPTION_REFOPTION_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_OPTION_REFOPTION_H
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+template <typename T>
+class Option;
+
+/**
+ * @class Option<T&>
+ *
+ * @brief 特化模板类，表示一个可选的引用。
+ *
+ * 内部只保存指向外部对象的指针，既不拷贝也不分配内存，适合容器查找等需要返回引用的场景。
+ * 被引用对象的生命周期必须长于该 Option。
+ *
+ * @tparam T 被引用对象的类型。
+ */
+template <typename T>
+class Option<T&>
+{
+public:
+    using value_type = T&;
+
+    /**
+     * @brief 默认构造函数，初始化为空。
+     */
+    Option() : m_ref(nullptr)
+    {
+    }
+
+    /**
+     * @brief 构造函数，引用给定的对象。
+     *
+     * @param val 被引用的对象。
+     */
+    explicit Option(T& val) : m_ref(std::addressof(val))
+    {
+    }
+
+    /**
+     * @brief 禁止绑定到临时对象。
+     */
+    explicit Option(T&& val) = delete;
+
+    /**
+     * @brief 检查 Option 是否为空。
+     *
+     * @return 如果 Option 为空，则返回 true；否则返回 false。
+     */
+    [[nodiscard]] bool isNull() const
+    {
+        return m_ref == nullptr;
+    }
+
+    /**
+     * @brief 解引用 Option 以获取被引用的对象。
+     *
+     * @return 返回被引用对象的引用。
+     */
+    T& operator*() const
+    {
+        return *m_ref;
+    }
+
+    /**
+     * @brief 获取指向被引用对象的指针。
+     *
+     * @return 返回指向被引用对象的指针。
+     */
+    T* operator->() const
+    {
+        return m_ref;
+    }
+
+    /**
+     * @brief 显式转换为布尔值。
+     *
+     * @return 如果 Option 不为空，则返回 true；否则返回 false。
+     */
+    operator bool() const
+    {
+        return !isNull();
+    }
+
+    /**
+     * @brief 比较两个 Option 对象是否不相等。
+     *
+     * @tparam U 另一个 Option 对象中值的类型。
+     * @param other 要比较的另一个 Option 对象。
+     * @return 如果两个 Option 对象都不为空且值不相等，或者一个为空而另一个不为空，则返回 true；否则返回 false。
+     */
+    template <typename U>
+    bool operator!=(const Option<U>& other) const
+    {
+        if (!this->isNull() && !other.isNull())
+        {
+            return *m_ref != *other;
+        }
+        return this->isNull() != other.isNull();
+    }
+
+    /**
+     * @brief 比较两个 Option 对象是否相等。
+     *
+     * @tparam U 另一个 Option 对象中值的类型。
+     * @param other 要比较的另一个 Option 对象。
+     * @return 如果两个 Option 对象都为空，或者都不为空且值相等，则返回 true；否则返回 false。
+     */
+    template <typename U>
+    bool operator==(const Option<U>& other) const
+    {
+        return !(*this != other);
+    }
+
+    /**
+     * @brief 比较 Option<void> 和引用 Option 是否相等。
+     *
+     * @return 如果当前 Option 为空，则返回 true；否则返回 false。
+     */
+    bool operator==(const Option<void>&) const
+    {
+        return isNull();
+    }
+
+    /**
+     * @brief 比较 Option<void> 和引用 Option 是否不相等。
+     *
+     * @return 如果当前 Option 不为空，则返回 true；否则返回 false。
+     */
+    bool operator!=(const Option<void>&) const
+    {
+        return !isNull();
+    }
+
+    /**
+     * @brief 重新绑定到另一个对象。
+     *
+     * @param val 新的被引用对象。
+     * @return 返回当前 Option 对象的引用。
+     */
+    Option<T&>& operator<<(T& val)
+    {
+        m_ref = std::addressof(val);
+        return *this;
+    }
+
+    /**
+     * @brief 对被引用对象应用函数，返回包含结果的新 Option；为空时返回空 Option。
+     *
+     * 函数返回左值引用时结果为 Option<U&>，否则为 Option<U>。
+     *
+     * @tparam F 函数类型，签名为 U(T&)。
+     * @param f 要应用的函数。
+     * @return 包含函数结果的 Option。
+     */
+    template <typename F>
+    auto map(F&& f) const
+    {
+        using __result = std::invoke_result_t<F, T&>;
+        static_assert(!std::is_void_v<__result>, "Option::map: function must return a value, use transform instead");
+        using __mapped = std::conditional_t<std::is_lvalue_reference_v<__result>, __result, std::remove_cvref_t<__result>>;
+        if (isNull())
+        {
+            return Option<__mapped>();
+        }
+        return Option<__mapped>(std::invoke(std::forward<F>(f), *m_ref));
+    }
+
+    /**
+     * @brief 对被引用对象应用返回 Option 的函数，并直接返回该结果；为空时返回空 Option。
+     *
+     * @tparam F 函数类型，签名为 Option<U>(T&)。
+     * @param f 要应用的函数。
+     * @return 函数返回的 Option。
+     */
+    template <typename F>
+    auto and_then(F&& f) const
+    {
+        using __result = std::remove_cvref_t<std::invoke_result_t<F, T&>>;
+        if (isNull())
+        {
+            return __result();
+        }
+        return std::invoke(std::forward<F>(f), *m_ref);
+    }
+
+    /**
+     * @brief 不为空时返回自身，为空时返回函数生成的 Option。
+     *
+     * @tparam F 函数类型，签名为 Option<T&>()。
+     * @param f 为空时调用的函数。
+     * @return 自身或函数生成的 Option。
+     */
+    template <typename F>
+    Option<T&> or_else(F&& f) const
+    {
+        static_assert(std::is_same_v<std::remove_cvref_t<std::invoke_result_t<F>>, Option<T&>>, "Option::or_else: function must return Option<T&>");
+        if (!isNull())
+        {
+            return *this;
+        }
+        return std::invoke(std::forward<F>(f));
+    }
+
+    /**
+     * @brief 获取被引用的对象，为空时返回默认对象。
+     *
+     * @param defaultValue 默认对象。
+     * @return 被引用的对象或默认对象的引用。
+     */
+    T& value_or(T& defaultValue) const
+    {
+        return isNull() ? defaultValue : *m_ref;
+    }
+
+    /**
+     * @brief 就地变换被引用的对象，为空时不做任何操作。
+     *
+     * @tparam F 函数类型，签名为 void(T&)。
+     * @param f 要应用的函数。
+     * @return 返回当前 Option 对象的引用，便于链式调用。
+     */
+    template <typename F>
+    const Option<T&>& transform(F&& f) const
+    {
+        if (!isNull())
+        {
+            std::invoke(std::forward<F>(f), *m_ref);
+        }
+        return *this;
+    }
+
+private:
+    /**
+     * @brief 指向被引用对象的指针，为空时为 nullptr。
+     */
+    T* m_ref;
+};
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_OPTION_REFOPTION_H
@@ -6,7 +6,11 @@
 #define TBS_TOOL_LIB_BASE_INCLUDE_STRING_UTILS_H_
 
 #include <string>
+#include <string_view>
 #include "defs.h"
+#include "strings/CharSet.h"
+#include "strings/Search.h"
+#include "strings/Split.h"
 
 /**
  * 检查给定的C风格字符串是否为空
@@ -50,6 +54,15 @@ bool isNumber(CONST char *str);
  */
 bool isNumber(CONST std::string &str);
 
+/**
+ * 检查给定的字符串视图是否只包含数字字符
+ *
+ * 在支持 SSE2 / AVX2 的 CPU 上每条指令检查 16 / 32 个字节，运行时自动选择
+ * @param str 待检查的字符串视图
+ * @return 如果字符串非空且只包含数字字符则返回true，否则返回false
+ */
+bool isNumber(std::string_view str);
+
 /**
  * 检查给定的std::wstring对象是否只包含数字字符
  * @param str 待检查的宽字符串对象
@@ -101,6 +114,15 @@ bool isCharacters(CONST char *str);
  */
 bool isCharacters(CONST std::string &str);
 
+/**
+ * 检查给定的字符串视图是否只包含字母字符
+ *
+ * 在支持 SSE2 / AVX2 的 CPU 上每条指令检查 16 / 32 个字节，运行时自动选择
+ * @param str 待检查的字符串视图
+ * @return 如果字符串非空且只包含字母字符则返回true，否则返回false
+ */
+bool isCharacters(std::string_view str);
+
 /**
  * 检查给定的std::wstring对象是否只包含字母字符
  * @param str 待检查的宽字符串对象
@@ -168,6 +190,29 @@ std::string toLower(CONST char *str);
  */
 std::string toLower(CONST std::string &str);
 
+/**
+ * @brief 将给定的字符串视图转换为小写，只分配一次结果字符串。
+ *
+ * @param str 要转换的字符串视图。
+ * @return std::string 转换后的小写字符串。
+ */
+std::string toLower(std::string_view str);
+
+/**
+ * @brief 就地将字符缓冲区中的 ASCII 大写字母转换为小写。
+ *
+ * @param str 字符缓冲区。
+ * @param len 缓冲区长度。
+ */
+void toLowerInPlace(char *str, size_t len);
+
+/**
+ * @brief 就地将 `std::string` 中的 ASCII 大写字母转换为小写。
+ *
+ * @param str 要转换的字符串。
+ */
+void toLowerInPlace(std::string &str);
+
 /**
  * @brief 将给定的宽字符 C 风格字符串转换为小写。
  *
@@ -200,6 +245,29 @@ std::string toUpper(CONST char *str);
  */
 std::string toUpper(CONST std::string &str);
 
+/**
+ * @brief 将给定的字符串视图转换为大写，只分配一次结果字符串。
+ *
+ * @param str 要转换的字符串视图。
+ * @return std::string 转换后的大写字符串。
+ */
+std::string toUpper(std::string_view str);
+
+/**
+ * @brief 就地将字符缓冲区中的 ASCII 小写字母转换为大写。
+ *
+ * @param str 字符缓冲区。
+ * @param len 缓冲区长度。
+ */
+void toUpperInPlace(char *str, size_t len);
+
+/**
+ * @brief 就地将 `std::string` 中的 ASCII 小写字母转换为大写。
+ *
+ * @param str 要转换的字符串。
+ */
+void toUpperInPlace(std::string &str);
+
 /**
  * @brief 将给定的宽字符 C 风格字符串转换为大写。
  *
@@ -216,6 +284,60 @@ std::wstring toUpper(CONST wchar_t *str);
  */
 std::wstring toUpper(CONST std::wstring &str);
 
+/**
+ * @brief 从左侧移除指定字符集中的字符，返回原字符串上的视图，不分配内存。
+ *
+ * @param str 要处理的字符串视图。
+ * @param chars 要移除的字符集。
+ * @return std::string_view 指向原字符串的子视图。
+ */
+std::string_view trimLeftView(std::string_view str, CONST CharSet &chars);
+
+/**
+ * @brief 从左侧移除指定字符集中的字符，返回原字符串上的视图，不分配内存。
+ *
+ * @param str 要处理的字符串视图。
+ * @param chars 要移除的字符，默认为空白字符。
+ * @return std::string_view 指向原字符串的子视图。
+ */
+std::string_view trimLeftView(std::string_view str, std::string_view chars = " \t\n\r");
+
+/**
+ * @brief 从右侧移除指定字符集中的字符，返回原字符串上的视图，不分配内存。
+ *
+ * @param str 要处理的字符串视图。
+ * @param chars 要移除的字符集。
+ * @return std::string_view 指向原字符串的子视图。
+ */
+std::string_view trimRightView(std::string_view str, CONST CharSet &chars);
+
+/**
+ * @brief 从右侧移除指定字符集中的字符，返回原字符串上的视图，不分配内存。
+ *
+ * @param str 要处理的字符串视图。
+ * @param chars 要移除的字符，默认为空白字符。
+ * @return std::string_view 指向原字符串的子视图。
+ */
+std::string_view trimRightView(std::string_view str, std::string_view chars = " \t\n\r");
+
+/**
+ * @brief 从两侧移除指定字符集中的字符，返回原字符串上的视图，不分配内存。
+ *
+ * @param str 要处理的字符串视图。
+ * @param chars 要移除的字符集。
+ * @return std::string_view 指向原字符串的子视图。
+ */
+std::string_view trimView(std::string_view str, CONST CharSet &chars);
+
+/**
+ * @brief 从两侧移除指定字符集中的字符，返回原字符串上的视图，不分配内存。
+ *
+ * @param str 要处理的字符串视图。
+ * @param chars 要移除的字符，默认为空白字符。
+ * @return std::string_view 指向原字符串的子视图。
+ */
+std::string_view trimView(std::string_view str, std::string_view chars = " \t\n\r");
+
 /**
  * @brief 从左侧移除指定字符集中的字符。
  *
@@ -364,6 +486,38 @@ size_t find(CONST wchar_t *str, CONST wchar_t *subStr, bool &found);
  */
 size_t find(CONST std::wstring &str, CONST wchar_t *subStr, bool &found);
 
+/**
+ * @brief 在字符串视图中查找子字符串的位置，使用 fastFind 实现。
+ *
+ * @param str 要搜索的字符串视图。
+ * @param subStr 要查找的子字符串。
+ * @param found 指示是否找到子字符串的布尔值。
+ * @return size_t 子字符串的位置，如果未找到则返回 0。
+ */
+size_t find(std::string_view str, std::string_view subStr, bool &found);
+
+/**
+ * @brief 替换字符串视图中第一次出现的子字符串，结果只分配一次。
+ *
+ * @param str 原始字符串视图。
+ * @param oldStr 要替换的子字符串。
+ * @param newStr 新的子字符串。
+ * @return std::string 替换后的字符串，未找到时返回原字符串的拷贝。
+ */
+std::string replace(std::string_view str, std::string_view oldStr, std::string_view newStr);
+
+/**
+ * @brief 替换字符串中所有不重叠出现的子字符串。
+ *
+ * 先统计出现次数以计算结果长度，只分配一次结果字符串，再按顺序写出。
+ *
+ * @param str 原始字符串视图。
+ * @param oldStr 要替换的子字符串，为空时返回原字符串的拷贝。
+ * @param newStr 新的子字符串。
+ * @return std::string 替换后的字符串。
+ */
+std::string replaceAll(std::string_view str, std::string_view oldStr, std::string_view newStr);
+
 /**
  * @brief 替换字符串中的子字符串。
  *
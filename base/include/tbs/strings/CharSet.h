@@ -0,0 +1,224 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_CHARSET_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_CHARSET_H
+
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief 基于 256 位查找表的字节字符集。
+ *
+ * 每个字节值对应一个比特位，成员判断只需一次移位与按位与，构造完全在编译期完成，
+ * 用来替代每次调用都要构建的 std::unordered_set<char>。
+ */
+class CharSet
+{
+public:
+    /**
+     * @brief 构造一个空字符集。
+     */
+    constexpr CharSet() = default;
+
+    /**
+     * @brief 以字符串中的所有字节构造字符集。
+     *
+     * @param chars 字符集中的字符。
+     */
+    constexpr explicit CharSet(std::string_view chars)
+    {
+        for (char c : chars)
+        {
+            add(c);
+        }
+    }
+
+    /**
+     * @brief 添加一个字符。
+     *
+     * @param c 要添加的字符。
+     * @return 返回当前字符集的引用。
+     */
+    constexpr CharSet& add(char c)
+    {
+        auto u = static_cast<unsigned char>(c);
+        m_bits[u >> 6] |= uint64_t{1} << (u & 63);
+        return *this;
+    }
+
+    /**
+     * @brief 添加闭区间 [lo, hi] 内的所有字符。
+     *
+     * @param lo 区间起点。
+     * @param hi 区间终点。
+     * @return 返回当前字符集的引用。
+     */
+    constexpr CharSet& addRange(char lo, char hi)
+    {
+        for (unsigned u = static_cast<unsigned char>(lo); u <= static_cast<unsigned char>(hi); u++)
+        {
+            add(static_cast<char>(u));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 移除一个字符。
+     *
+     * @param c 要移除的字符。
+     * @return 返回当前字符集的引用。
+     */
+    constexpr CharSet& remove(char c)
+    {
+        auto u = static_cast<unsigned char>(c);
+        m_bits[u >> 6] &= ~(uint64_t{1} << (u & 63));
+        return *this;
+    }
+
+    /**
+     * @brief 判断字符是否在字符集中。
+     *
+     * @param c 要判断的字符。
+     * @return 在字符集中返回 true，否则返回 false。
+     */
+    [[nodiscard]] constexpr bool contains(char c) const
+    {
+        auto u = static_cast<unsigned char>(c);
+        return (m_bits[u >> 6] >> (u & 63)) & 1;
+    }
+
+    /**
+     * @brief 获取字符集中的字符个数。
+     *
+     * @return 字符个数。
+     */
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return std::popcount(m_bits[0]) + std::popcount(m_bits[1]) + std::popcount(m_bits[2]) + std::popcount(m_bits[3]);
+    }
+
+    /**
+     * @brief 判断字符集是否为空。
+     *
+     * @return 为空返回 true，否则返回 false。
+     */
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return (m_bits[0] | m_bits[1] | m_bits[2] | m_bits[3]) == 0;
+    }
+
+    /**
+     * @brief 从 pos 开始查找第一个属于字符集的字符。
+     *
+     * @param str 要查找的字符串。
+     * @param pos 起始位置。
+     * @return 字符位置，未找到返回 std::string_view::npos。
+     */
+    [[nodiscard]] constexpr size_t findFirstOf(std::string_view str, size_t pos = 0) const
+    {
+        for (; pos < str.size(); pos++)
+        {
+            if (contains(str[pos]))
+            {
+                return pos;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    /**
+     * @brief 从 pos 开始查找第一个不属于字符集的字符。
+     *
+     * @param str 要查找的字符串。
+     * @param pos 起始位置。
+     * @return 字符位置，未找到返回 std::string_view::npos。
+     */
+    [[nodiscard]] constexpr size_t findFirstNotOf(std::string_view str, size_t pos = 0) const
+    {
+        for (; pos < str.size(); pos++)
+        {
+            if (!contains(str[pos]))
+            {
+                return pos;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    /**
+     * @brief 从末尾向前查找最后一个不属于字符集的字符。
+     *
+     * @param str 要查找的字符串。
+     * @return 字符位置，未找到返回 std::string_view::npos。
+     */
+    [[nodiscard]] constexpr size_t findLastNotOf(std::string_view str) const
+    {
+        for (size_t i = str.size(); i > 0; i--)
+        {
+            if (!contains(str[i - 1]))
+            {
+                return i - 1;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    /**
+     * @brief 求两个字符集的并集。
+     */
+    constexpr CharSet operator|(const CharSet& other) const
+    {
+        CharSet r;
+        for (int i = 0; i < 4; i++)
+        {
+            r.m_bits[i] = m_bits[i] | other.m_bits[i];
+        }
+        return r;
+    }
+
+    /**
+     * @brief 求两个字符集的交集。
+     */
+    constexpr CharSet operator&(const CharSet& other) const
+    {
+        CharSet r;
+        for (int i = 0; i < 4; i++)
+        {
+            r.m_bits[i] = m_bits[i] & other.m_bits[i];
+        }
+        return r;
+    }
+
+    /**
+     * @brief 求字符集的补集。
+     */
+    constexpr CharSet operator~() const
+    {
+        CharSet r;
+        for (int i = 0; i < 4; i++)
+        {
+            r.m_bits[i] = ~m_bits[i];
+        }
+        return r;
+    }
+
+    constexpr bool operator==(const CharSet& other) const = default;
+
+    /**
+     * @brief 默认的空白字符集，与 trim 系列函数的默认参数一致。
+     *
+     * @return 包含空格、制表符、换行与回车的字符集。
+     */
+    static constexpr CharSet whitespace()
+    {
+        return CharSet(" \t\n\r");
+    }
+
+private:
+    uint64_t m_bits[4]{};
+};
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_CHARSET_H
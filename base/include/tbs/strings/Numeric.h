@@ -0,0 +1,248 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_NUMERIC_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_NUMERIC_H
+
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <tbs/Option.h>
+#include <tbs/strings/Split.h>
+
+/**
+ * @brief 可被本文件中的解析与格式化函数处理的数值类型（bool 与字符类型除外）。
+ */
+template <typename T>
+concept ParsableNumber = (std::integral<T> || std::floating_point<T>) && !std::same_as<T, bool> && !std::same_as<T, char>;
+
+/**
+ * @brief 解析不超过 19 位的十进制数字串，每次用 SWAR 处理 8 位数字。
+ *
+ * @param str 数字串首地址。
+ * @param len 数字串长度，必须在 1 到 19 之间。
+ * @param out 解析结果。
+ * @return 全部为数字时返回 true，否则返回 false。
+ */
+bool parseDecimalDigits(CONST char* str, size_t len, uint64_t& out);
+
+/**
+ * @brief 把字符串完整解析为整数，不依赖区域设置，不抛出异常，不分配内存。
+ *
+ * 允许一个前导 '+'（有符号类型还允许 '-'），整个字符串都必须是合法数字。十进制且不超过 19 位时走
+ * SWAR 快速路径，其余情况使用 std::from_chars。
+ *
+ * @tparam T 整数类型。
+ * @param str 要解析的字符串。
+ * @param base 进制，默认为 10。
+ * @return 解析结果，格式错误或溢出时为空。
+ */
+template <std::integral T>
+    requires(!std::same_as<T, bool>)
+Option<T> parseInt(std::string_view str, int base = 10)
+{
+    bool negative = false;
+    std::string_view digits = str;
+    if (!digits.empty() && (digits[0] == '+' || digits[0] == '-'))
+    {
+        negative = digits[0] == '-';
+        digits.remove_prefix(1);
+    }
+    // 只允许一个符号：from_chars 会接受去掉 '+' 后剩下的 '-'
+    if (digits.empty() || digits[0] == '+' || digits[0] == '-' || (negative && std::is_unsigned_v<T>))
+    {
+        return Option<T>();
+    }
+    if (base == 10 && digits.size() <= 19)
+    {
+        uint64_t v = 0;
+        if (!parseDecimalDigits(digits.data(), digits.size(), v))
+        {
+            return Option<T>();
+        }
+        using U = std::make_unsigned_t<T>;
+        if (negative)
+        {
+            // 有符号类型的最小值的绝对值比最大值大 1
+            if (v > static_cast<uint64_t>(std::numeric_limits<T>::max()) + 1)
+            {
+                return Option<T>();
+            }
+            return Option<T>(static_cast<T>(static_cast<U>(0) - static_cast<U>(v)));
+        }
+        if (v > static_cast<uint64_t>(std::numeric_limits<T>::max()))
+        {
+            return Option<T>();
+        }
+        return Option<T>(static_cast<T>(v));
+    }
+    // from_chars 自己处理 '-'，这里只去掉 '+'
+    std::string_view s = negative ? str : digits;
+    T value{};
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value, base);
+    if (ec != std::errc() || ptr != s.data() + s.size())
+    {
+        return Option<T>();
+    }
+    return Option<T>(value);
+}
+
+/**
+ * @brief 把字符串完整解析为浮点数，不依赖区域设置，不抛出异常，不分配内存。
+ *
+ * @tparam T 浮点类型。
+ * @param str 要解析的字符串，允许一个前导 '+'。
+ * @param format 允许的格式，默认为 std::chars_format::general。
+ * @return 解析结果，格式错误或超出范围时为空。
+ */
+template <std::floating_point T>
+Option<T> parseFloat(std::string_view str, std::chars_format format = std::chars_format::general)
+{
+    if (!str.empty() && str[0] == '+')
+    {
+        str.remove_prefix(1);
+        if (!str.empty() && str[0] == '-')
+        {
+            return Option<T>();
+        }
+    }
+    if (str.empty())
+    {
+        return Option<T>();
+    }
+    T value{};
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value, format);
+    if (ec != std::errc() || ptr != str.data() + str.size())
+    {
+        return Option<T>();
+    }
+    return Option<T>(value);
+}
+
+/**
+ * @brief 按类型选择 parseInt 或 parseFloat。
+ *
+ * @tparam T 数值类型。
+ * @param str 要解析的字符串。
+ * @return 解析结果，失败时为空。
+ */
+template <ParsableNumber T>
+Option<T> parseNumber(std::string_view str)
+{
+    if constexpr (std::integral<T>)
+    {
+        return parseInt<T>(str);
+    }
+    else
+    {
+        return parseFloat<T>(str);
+    }
+}
+
+/**
+ * @brief 数值格式化后的最大字符数，按此大小准备缓冲区即可保证 toChars 成功。
+ *
+ * @tparam T 数值类型。
+ */
+template <ParsableNumber T>
+constexpr size_t MAX_NUMBER_CHARS = std::integral<T> ? std::numeric_limits<T>::digits10 + 3 : 32;
+
+/**
+ * @brief 把数值格式化到调用者提供的缓冲区中（最短可往返表示），不分配内存。
+ *
+ * @tparam T 数值类型。
+ * @param buffer 缓冲区。
+ * @param size 缓冲区大小。
+ * @param value 要格式化的数值。
+ * @return 指向缓冲区中结果的视图，缓冲区不足时返回空视图。
+ */
+template <ParsableNumber T>
+std::string_view toChars(char* buffer, size_t size, T value)
+{
+    auto [ptr, ec] = std::to_chars(buffer, buffer + size, value);
+    if (ec != std::errc())
+    {
+        return std::string_view();
+    }
+    return std::string_view(buffer, ptr - buffer);
+}
+
+/**
+ * @brief 把数值格式化到调用者提供的数组中。
+ *
+ * @tparam T 数值类型。
+ * @tparam N 数组大小。
+ * @param buffer 字符数组。
+ * @param value 要格式化的数值。
+ * @return 指向数组中结果的视图，数组不足时返回空视图。
+ */
+template <ParsableNumber T, size_t N>
+std::string_view toChars(char (&buffer)[N], T value)
+{
+    return toChars(buffer, N, value);
+}
+
+/**
+ * @brief 把一列字段批量解析为数值。
+ *
+ * @tparam T 数值类型。
+ * @param fields 字段列表。
+ * @param out 输出数组，大小不得小于 fields，解析失败的位置写入 T{}。
+ * @param valid 可选的输出数组，记录每个字段是否解析成功；为空时不记录。
+ * @return 解析成功的字段数。
+ */
+template <ParsableNumber T>
+size_t parseColumn(std::span<CONST std::string_view> fields, std::span<T> out, std::span<bool> valid = {})
+{
+    if (out.size() < fields.size() || (!valid.empty() && valid.size() < fields.size()))
+    {
+        throw tbs::base_error("parseColumn: output buffer is smaller than the input column");
+    }
+    size_t ok = 0;
+    for (size_t i = 0; i < fields.size(); i++)
+    {
+        Option<T> v = parseNumber<T>(fields[i]);
+        out[i] = v.value_or(T{});
+        if (!valid.empty())
+        {
+            valid[i] = !v.isNull();
+        }
+        ok += v.isNull() ? 0 : 1;
+    }
+    return ok;
+}
+
+/**
+ * @brief 把以分隔符分隔的一列文本批量解析为数值，追加到 out 中。
+ *
+ * 空段会被跳过（按 tokenize 切分），无法解析的段不会写入 out。
+ *
+ * @tparam T 数值类型。
+ * @param text 一列文本，例如 "1,2,3" 或一行一个数值的文本块。
+ * @param delimiters 分隔符。
+ * @param out 输出数组。
+ * @return 无法解析的段数。
+ */
+template <ParsableNumber T>
+size_t parseColumn(std::string_view text, std::string_view delimiters, std::vector<T>& out)
+{
+    size_t failed = 0;
+    for (std::string_view field : tokenize(text, delimiters))
+    {
+        Option<T> v = parseNumber<T>(field);
+        if (v.isNull())
+        {
+            failed++;
+            continue;
+        }
+        out.push_back(*v);
+    }
+    return failed;
+}
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_NUMERIC_H
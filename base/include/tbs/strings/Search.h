@@ -0,0 +1,203 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_SEARCH_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_SEARCH_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <tbs/defs.h>
+
+/**
+ * @brief 短模式串的长度上限，不超过该长度时使用 SIMD 首尾字节过滤，否则使用 Horspool。
+ */
+constexpr size_t SHORT_NEEDLE_MAX = 32;
+
+/**
+ * @brief 在字符串中查找子串第一次出现的位置。
+ *
+ * 单字节模式串直接使用 memchr；短模式串按 16 / 32 字节一组同时比较首字节与尾字节，只对候选位置做
+ * memcmp（SSE2 / AVX2 运行时选择）；长模式串使用 Boyer-Moore-Horspool。
+ *
+ * @param haystack 被搜索的字符串。
+ * @param needle 要查找的子串。
+ * @param pos 起始位置。
+ * @return 子串位置，未找到返回 std::string_view::npos；needle 为空时返回 pos（与 std::string_view::find 一致）。
+ */
+size_t fastFind(std::string_view haystack, std::string_view needle, size_t pos = 0);
+
+/**
+ * @brief 统计子串不重叠出现的次数。
+ *
+ * @param haystack 被搜索的字符串。
+ * @param needle 要统计的子串，为空时返回 0。
+ * @return 出现次数。
+ */
+size_t countOccurrences(std::string_view haystack, std::string_view needle);
+
+/**
+ * @brief 预处理过的单模式串搜索器，适合用同一个模式串反复搜索。
+ *
+ * 构造时复制模式串并（对长模式串）预先计算 Horspool 跳转表，之后每次搜索都不再分配内存。
+ */
+class StringSearcher
+{
+public:
+    /**
+     * @brief 构造函数。
+     *
+     * @param needle 模式串。
+     */
+    explicit StringSearcher(std::string_view needle);
+
+    /**
+     * @brief 查找模式串第一次出现的位置。
+     *
+     * @param haystack 被搜索的字符串。
+     * @param pos 起始位置。
+     * @return 模式串位置，未找到返回 std::string_view::npos。
+     */
+    [[nodiscard]] size_t find(std::string_view haystack, size_t pos = 0) const;
+
+    /**
+     * @brief 统计模式串不重叠出现的次数。
+     *
+     * @param haystack 被搜索的字符串。
+     * @return 出现次数。
+     */
+    [[nodiscard]] size_t count(std::string_view haystack) const;
+
+    /**
+     * @brief 获取模式串。
+     *
+     * @return 模式串视图。
+     */
+    [[nodiscard]] std::string_view needle() const;
+
+private:
+    std::string m_needle;
+    std::array<size_t, 256> m_shift{};
+};
+
+/**
+ * @brief Aho-Corasick 多模式串匹配器。
+ *
+ * 构造时把所有模式串建成完整的确定性自动机（每个状态 256 个转移），匹配时每个输入字节只做一次
+ * 查表，与模式串数量无关。空模式串会被忽略。
+ */
+class AhoCorasick
+{
+public:
+    /**
+     * @brief 一次匹配的结果。
+     */
+    struct Match
+    {
+        /**
+         * @brief 匹配在文本中的起始位置。
+         */
+        size_t position;
+
+        /**
+         * @brief 匹配到的模式串下标（构造时的顺序）。
+         */
+        size_t pattern;
+
+        /**
+         * @brief 匹配的长度。
+         */
+        size_t length;
+    };
+
+    /**
+     * @brief 以模式串列表构造。
+     *
+     * @param patterns 模式串列表。
+     */
+    AhoCorasick(std::initializer_list<std::string_view> patterns);
+
+    /**
+     * @brief 以任意字符串容器构造。
+     *
+     * @tparam R 容器类型，元素需可转换为 std::string_view。
+     * @param patterns 模式串容器。
+     */
+    template <typename R>
+        requires(!std::is_same_v<std::remove_cvref_t<R>, AhoCorasick>)
+    explicit AhoCorasick(const R& patterns)
+    {
+        std::vector<std::string_view> views;
+        for (const auto& p : patterns)
+        {
+            views.emplace_back(p);
+        }
+        build(views);
+    }
+
+    /**
+     * @brief 依次报告文本中的所有匹配（包括重叠的匹配），按匹配结束位置排序。
+     *
+     * @param text 被搜索的文本。
+     * @param f 回调函数，返回 false 时停止搜索。
+     */
+    void foreachMatch(std::string_view text, CONST std::function<bool(CONST Match&)>& f) const;
+
+    /**
+     * @brief 获取文本中的所有匹配。
+     *
+     * @param text 被搜索的文本。
+     * @return 所有匹配。
+     */
+    [[nodiscard]] std::vector<Match> findAll(std::string_view text) const;
+
+    /**
+     * @brief 判断文本中是否包含任意一个模式串。
+     *
+     * @param text 被搜索的文本。
+     * @return 包含返回 true，否则返回 false。
+     */
+    [[nodiscard]] bool containsAny(std::string_view text) const;
+
+    /**
+     * @brief 获取模式串数量（包括被忽略的空模式串）。
+     *
+     * @return 模式串数量。
+     */
+    [[nodiscard]] size_t patternCount() const;
+
+private:
+    void build(CONST std::vector<std::string_view>& patterns);
+
+    /**
+     * @brief 状态转移表，下标为 state * 256 + byte。
+     */
+    std::vector<uint32_t> m_delta;
+
+    /**
+     * @brief 每个状态上结束的第一个模式串，没有则为 -1。
+     */
+    std::vector<int32_t> m_terminal;
+
+    /**
+     * @brief 沿失败链最近的一个有输出的状态，没有则为 -1。
+     */
+    std::vector<int32_t> m_dictLink;
+
+    /**
+     * @brief 与某个模式串内容相同的下一个模式串，没有则为 -1。
+     */
+    std::vector<int32_t> m_samePattern;
+
+    /**
+     * @brief 各模式串的长度。
+     */
+    std::vector<size_t> m_lengths;
+};
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_SEARCH_H
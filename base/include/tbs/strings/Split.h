@@ -0,0 +1,408 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_SPLIT_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_SPLIT_H
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <tbs/defs.h>
+#include <tbs/strings/CharSet.h>
+
+/**
+ * @brief 分隔符集合，负责在字符串中定位下一个分隔符。
+ *
+ * 分隔符不超过 MAX_SIMD_CHARS 个时（逗号、制表符、空白等常见情况），每次按 16 / 32 字节一组同时与所有
+ * 分隔符比较（SSE2 / AVX2 运行时选择）；否则退化为逐字节查 256 位表。
+ */
+class DelimiterSet
+{
+public:
+    /**
+     * @brief 走 SIMD 路径的最大分隔符个数。
+     */
+    constexpr static size_t MAX_SIMD_CHARS = 8;
+
+    /**
+     * @brief 以字符串中的所有字节作为分隔符。
+     *
+     * @param chars 分隔符。
+     */
+    explicit DelimiterSet(std::string_view chars);
+
+    /**
+     * @brief 以字符集作为分隔符。
+     *
+     * @param chars 分隔符字符集。
+     */
+    explicit DelimiterSet(CONST CharSet& chars);
+
+    /**
+     * @brief 从 pos 开始查找第一个分隔符。
+     *
+     * @param str 要查找的字符串。
+     * @param pos 起始位置。
+     * @return 分隔符位置，未找到返回 std::string_view::npos。
+     */
+    [[nodiscard]] size_t find(std::string_view str, size_t pos = 0) const;
+
+    /**
+     * @brief 判断字符是否为分隔符。
+     *
+     * @param c 要判断的字符。
+     * @return 是分隔符返回 true，否则返回 false。
+     */
+    [[nodiscard]] bool contains(char c) const
+    {
+        return m_set.contains(c);
+    }
+
+    /**
+     * @brief 获取分隔符字符集。
+     *
+     * @return 分隔符字符集。
+     */
+    [[nodiscard]] CONST CharSet& charSet() const
+    {
+        return m_set;
+    }
+
+private:
+    CharSet m_set;
+    char m_chars[MAX_SIMD_CHARS]{};
+
+    /**
+     * @brief 分隔符个数，超过 MAX_SIMD_CHARS 时为 0，表示只使用查找表。
+     */
+    size_t m_count = 0;
+};
+
+/**
+ * @brief 惰性的字符串切分区间，迭代时才定位下一段，产出指向原字符串的 std::string_view，不分配内存。
+ *
+ * 两种模式：
+ * - split：每个分隔符都切分一次，保留空段，"a,,b" 产出 "a"、""、"b"，空字符串产出一个空段；
+ * - tokenize：连续的分隔符视为一个，丢弃空段，"  a  b " 产出 "a"、"b"。
+ *
+ * 区间对象与被切分的字符串都必须在迭代期间保持有效。
+ */
+class SplitRange
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = CONST std::string_view*;
+        using reference = std::string_view;
+
+        iterator() = default;
+
+        std::string_view operator*() const
+        {
+            return m_current;
+        }
+
+        pointer operator->() const
+        {
+            return &m_current;
+        }
+
+        iterator& operator++()
+        {
+            m_range->advance(*this);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        bool operator==(CONST iterator& other) const
+        {
+            return m_pos == other.m_pos;
+        }
+
+    private:
+        friend class SplitRange;
+
+        CONST SplitRange* m_range = nullptr;
+
+        /**
+         * @brief 当前段的起点，迭代结束时为 npos。
+         */
+        size_t m_pos = std::string_view::npos;
+
+        /**
+         * @brief 当前段的终点（分隔符位置或字符串末尾）。
+         */
+        size_t m_end = 0;
+
+        std::string_view m_current;
+    };
+
+    /**
+     * @brief 构造函数。
+     *
+     * @param text 要切分的字符串。
+     * @param delimiters 分隔符集合。
+     * @param skipEmpty 为 true 时按 tokenize 模式处理。
+     */
+    SplitRange(std::string_view text, CONST DelimiterSet& delimiters, bool skipEmpty) : m_text(text), m_delimiters(delimiters), m_skipEmpty(skipEmpty)
+    {
+    }
+
+    [[nodiscard]] iterator begin() const
+    {
+        iterator it;
+        it.m_range = this;
+        locate(it, 0);
+        return it;
+    }
+
+    [[nodiscard]] iterator end() const
+    {
+        return iterator();
+    }
+
+    /**
+     * @brief 把所有段收集到 vector 中。
+     *
+     * @return 所有段。
+     */
+    [[nodiscard]] std::vector<std::string_view> toVector() const
+    {
+        return std::vector<std::string_view>(begin(), end());
+    }
+
+private:
+    /**
+     * @brief 从 from 开始定位一段，tokenize 模式下先跳过分隔符。
+     */
+    void locate(iterator& it, size_t from) const
+    {
+        if (m_skipEmpty)
+        {
+            from = m_delimiters.charSet().findFirstNotOf(m_text, from);
+            if (from == std::string_view::npos)
+            {
+                it.m_pos = std::string_view::npos;
+                return;
+            }
+        }
+        size_t e = m_delimiters.find(m_text, from);
+        it.m_pos = from;
+        it.m_end = e == std::string_view::npos ? m_text.size() : e;
+        it.m_current = m_text.substr(from, it.m_end - from);
+    }
+
+    void advance(iterator& it) const
+    {
+        if (it.m_end >= m_text.size())
+        {
+            it.m_pos = std::string_view::npos;
+            return;
+        }
+        locate(it, it.m_end + 1);
+    }
+
+    std::string_view m_text;
+    DelimiterSet m_delimiters;
+    bool m_skipEmpty;
+};
+
+/**
+ * @brief 按分隔符切分字符串，保留空段。
+ *
+ * @param text 要切分的字符串。
+ * @param delimiters 分隔符，其中任意一个字节都作为分隔符。
+ * @return 惰性切分区间。
+ */
+SplitRange split(std::string_view text, std::string_view delimiters);
+
+/**
+ * @brief 按分隔符字符集切分字符串，保留空段。
+ *
+ * @param text 要切分的字符串。
+ * @param delimiters 分隔符字符集。
+ * @return 惰性切分区间。
+ */
+SplitRange split(std::string_view text, CONST CharSet& delimiters);
+
+/**
+ * @brief 按分隔符把字符串切分为记号，连续分隔符视为一个，丢弃空段。
+ *
+ * @param text 要切分的字符串。
+ * @param delimiters 分隔符，默认为空白字符。
+ * @return 惰性切分区间。
+ */
+SplitRange tokenize(std::string_view text, std::string_view delimiters = " \t\n\r");
+
+/**
+ * @brief 按分隔符字符集把字符串切分为记号，连续分隔符视为一个，丢弃空段。
+ *
+ * @param text 要切分的字符串。
+ * @param delimiters 分隔符字符集。
+ * @return 惰性切分区间。
+ */
+SplitRange tokenize(std::string_view text, CONST CharSet& delimiters);
+
+/**
+ * @brief CSV 记录中的一个字段。
+ */
+struct CsvField
+{
+    /**
+     * @brief 字段内容；带引号的字段不含外层引号，其中的转义引号（""）保持原样。
+     */
+    std::string_view raw;
+
+    /**
+     * @brief 字段是否被引号包围。
+     */
+    bool quoted = false;
+
+    /**
+     * @brief 字段内是否含有转义引号，为 false 时 raw 就是最终值，不需要 value() 的拷贝。
+     */
+    bool escaped = false;
+
+    /**
+     * @brief 获取去除转义后的字段值。
+     *
+     * @param quote 引号字符。
+     * @return 字段值。
+     */
+    [[nodiscard]] std::string value(char quote = '"') const;
+};
+
+/**
+ * @brief 惰性的 CSV 字段切分区间，支持引号包围的字段以及其中的分隔符与转义引号。
+ *
+ * 处理单条记录（一行），"a,\"b,c\",\"d\"\"e\"" 产出 a、b,c、d""e（escaped 为 true）。
+ * 未闭合的引号字段延伸到记录末尾；闭合引号与下一个分隔符之间的多余字符被忽略。
+ */
+class CsvFieldRange
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = CsvField;
+        using difference_type = std::ptrdiff_t;
+        using pointer = CONST CsvField*;
+        using reference = CONST CsvField&;
+
+        iterator() = default;
+
+        CONST CsvField& operator*() const
+        {
+            return m_field;
+        }
+
+        pointer operator->() const
+        {
+            return &m_field;
+        }
+
+        iterator& operator++()
+        {
+            if (m_last)
+            {
+                m_pos = std::string_view::npos;
+            }
+            else
+            {
+                m_range->parse(*this, m_next);
+            }
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        bool operator==(CONST iterator& other) const
+        {
+            return m_pos == other.m_pos;
+        }
+
+    private:
+        friend class CsvFieldRange;
+
+        CONST CsvFieldRange* m_range = nullptr;
+        size_t m_pos = std::string_view::npos;
+        size_t m_next = 0;
+        bool m_last = false;
+        CsvField m_field;
+    };
+
+    /**
+     * @brief 构造函数。
+     *
+     * @param record 一条 CSV 记录。
+     * @param delimiter 字段分隔符。
+     * @param quote 引号字符。
+     */
+    explicit CsvFieldRange(std::string_view record, char delimiter = ',', char quote = '"') : m_record(record), m_delimiter(delimiter), m_quote(quote)
+    {
+    }
+
+    [[nodiscard]] iterator begin() const
+    {
+        iterator it;
+        it.m_range = this;
+        parse(it, 0);
+        return it;
+    }
+
+    [[nodiscard]] iterator end() const
+    {
+        return iterator();
+    }
+
+    /**
+     * @brief 把所有字段收集到 vector 中。
+     *
+     * @return 所有字段。
+     */
+    [[nodiscard]] std::vector<CsvField> toVector() const
+    {
+        return std::vector<CsvField>(begin(), end());
+    }
+
+private:
+    /**
+     * @brief 解析从 pos 开始的一个字段，并记录下一个字段的起点。
+     */
+    void parse(iterator& it, size_t pos) const;
+
+    std::string_view m_record;
+    char m_delimiter;
+    char m_quote;
+};
+
+/**
+ * @brief 按 CSV 规则切分一条记录。
+ *
+ * @param record 一条 CSV 记录。
+ * @param delimiter 字段分隔符，默认为逗号。
+ * @param quote 引号字符，默认为双引号。
+ * @return 惰性字段区间。
+ */
+CsvFieldRange splitCsv(std::string_view record, char delimiter = ',', char quote = '"');
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_SPLIT_H
@@ -0,0 +1,193 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_STRINGPOOL_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_STRINGPOOL_H
+
+#include <atomic>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#include <tbs/defs.h>
+#include <tbs/Option.h>
+#include <tbs/memory/Arena.h>
+
+/**
+ * @brief 字符串驻留池返回的 32 位句柄。
+ *
+ * 同一个池中内容相同的字符串得到相同的句柄，因此相等比较与哈希都只看整数，是 O(1) 的。
+ * 不同池的句柄之间没有可比性。默认构造的句柄无效。
+ */
+class InternedString
+{
+public:
+    constexpr InternedString() = default;
+
+    constexpr explicit InternedString(uint32_t id) : m_id(id)
+    {
+    }
+
+    /**
+     * @brief 获取句柄的序号。
+     *
+     * @return 序号，等于该字符串在池中的驻留顺序。
+     */
+    [[nodiscard]] constexpr uint32_t id() const
+    {
+        return m_id;
+    }
+
+    /**
+     * @brief 判断句柄是否有效。
+     *
+     * @return 有效返回 true，否则返回 false。
+     */
+    [[nodiscard]] constexpr bool isValid() const
+    {
+        return m_id != INVALID_ID;
+    }
+
+    constexpr bool operator==(const InternedString& other) const = default;
+
+    constexpr auto operator<=>(const InternedString& other) const = default;
+
+    /**
+     * @brief 无效句柄的序号。
+     */
+    constexpr static uint32_t INVALID_ID = UINT32_MAX;
+
+private:
+    uint32_t m_id = INVALID_ID;
+};
+
+template <>
+struct std::hash<InternedString>
+{
+    size_t operator()(const InternedString& s) const noexcept
+    {
+        // 句柄本身就是稠密且唯一的序号
+        return s.id();
+    }
+};
+
+/**
+ * @brief 线程安全的字符串驻留池。
+ *
+ * 字符串内容复制到池自带的 Arena 中，池存活期间视图一直有效。
+ * - 查找已驻留的字符串（find，以及 intern 的命中路径）是无锁的：只读取一个开放寻址哈希表；
+ * - 句柄到视图的解析（view）是无锁的：条目按倍增的分段存储，分段一旦发布就不再移动；
+ * - 只有插入新字符串与哈希表扩容需要加锁。
+ */
+class StringPool
+{
+public:
+    /**
+     * @brief 构造函数。
+     *
+     * @param chunkSize 字符串存储所用 Arena 的块大小。
+     */
+    explicit StringPool(size_t chunkSize = tbs::memory::Arena::DEFAULT_CHUNK_SIZE);
+
+    DELETE_COPY_CONSTRUCTION(StringPool)
+    DELETE_COPY_ASSIGNMENT(StringPool)
+
+    ~StringPool();
+
+    /**
+     * @brief 驻留一个字符串，已存在时直接返回已有句柄。
+     *
+     * @param str 要驻留的字符串。
+     * @return 字符串的句柄。
+     */
+    InternedString intern(std::string_view str);
+
+    /**
+     * @brief 无锁地查找一个已驻留的字符串，不会插入。
+     *
+     * @param str 要查找的字符串。
+     * @return 字符串的句柄，未驻留时为空。
+     */
+    [[nodiscard]] Option<InternedString> find(std::string_view str) const;
+
+    /**
+     * @brief 无锁地把句柄解析为字符串视图。
+     *
+     * @param handle 由本池返回的句柄。
+     * @return 字符串视图，池存活期间有效。
+     */
+    [[nodiscard]] std::string_view view(InternedString handle) const;
+
+    /**
+     * @brief 获取已驻留的字符串数量。
+     *
+     * @return 字符串数量。
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief 进程级的全局驻留池，适合日志器名称等全局共享的字符串。
+     *
+     * @return 全局驻留池。
+     */
+    static StringPool& global();
+
+private:
+    struct Entry
+    {
+        const char* data;
+        size_t length;
+        size_t hash;
+    };
+
+    struct Table
+    {
+        explicit Table(size_t capacity) : mask(capacity - 1), slots(new std::atomic<uint32_t>[capacity])
+        {
+            for (size_t i = 0; i < capacity; i++)
+            {
+                slots[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        size_t mask;
+
+        /**
+         * @brief 槽位保存句柄序号加一，0 表示空槽位。
+         */
+        std::unique_ptr<std::atomic<uint32_t>[]> slots;
+    };
+
+    /**
+     * @brief 第 0 段的条目数，之后每段翻倍。
+     */
+    constexpr static size_t FIRST_SEGMENT_SIZE = 64;
+
+    /**
+     * @brief 分段数，足以容纳 2^32 个条目。
+     */
+    constexpr static size_t SEGMENT_COUNT = 27;
+
+    CONST Entry& entryAt(uint32_t id) const;
+
+    [[nodiscard]] uint32_t probe(CONST Table& table, std::string_view str, size_t hash) const;
+
+    void insertSlot(Table& table, uint32_t id, size_t hash);
+
+    tbs::memory::Arena m_arena;
+    std::atomic<Entry*> m_segments[SEGMENT_COUNT];
+    std::atomic<Table*> m_table;
+    std::atomic<uint32_t> m_count{0};
+
+    /**
+     * @brief 扩容后被替换的旧表，可能仍有无锁读者在使用，析构时统一释放。
+     */
+    std::vector<std::unique_ptr<Table>> m_retired;
+    std::mutex m_mutex;
+};
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_STRINGPOOL_H
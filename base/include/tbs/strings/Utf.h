@@ -0,0 +1,94 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_UTF_H
+#define TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_UTF_H
+
+#include <string>
+#include <string_view>
+#include <tbs/Option.h>
+
+/**
+ * UTF-8 与 UTF-16 / UTF-32 / wchar_t 之间的转换。
+ *
+ * 所有转换都会校验输入（拒绝过长编码、代理项、超过 U+10FFFF 的码点以及不成对的 UTF-16 代理项），
+ * 非法输入返回空 Option。转换分两趟：第一趟校验并精确计算输出长度，第二趟直接写入一次性分配好的结果。
+ * 两趟中连续的 ASCII 字符都按 16 个一组向量化处理（SSE2），ASCII 为主的文本几乎只有内存拷贝的开销。
+ *
+ * wchar_t 在 Windows 上按 UTF-16 处理，在其他平台上按 UTF-32 处理。
+ */
+
+/**
+ * @brief 校验字符串是否为合法的 UTF-8。
+ *
+ * @param str 要校验的字符串。
+ * @return 合法返回 true，否则返回 false。
+ */
+bool isValidUtf8(std::string_view str);
+
+/**
+ * @brief 计算 UTF-8 字符串转为 UTF-16 后的码元数，同时校验。
+ *
+ * @param str UTF-8 字符串。
+ * @return 码元数，非法输入时为空。
+ */
+Option<size_t> utf16LengthOfUtf8(std::string_view str);
+
+/**
+ * @brief 计算 UTF-8 字符串中的码点数，同时校验。
+ *
+ * @param str UTF-8 字符串。
+ * @return 码点数，非法输入时为空。
+ */
+Option<size_t> codePointCountOfUtf8(std::string_view str);
+
+/**
+ * @brief UTF-8 转 UTF-16。
+ *
+ * @param str UTF-8 字符串。
+ * @return UTF-16 字符串，非法输入时为空。
+ */
+Option<std::u16string> utf8ToUtf16(std::string_view str);
+
+/**
+ * @brief UTF-8 转 UTF-32。
+ *
+ * @param str UTF-8 字符串。
+ * @return UTF-32 字符串，非法输入时为空。
+ */
+Option<std::u32string> utf8ToUtf32(std::string_view str);
+
+/**
+ * @brief UTF-8 转宽字符串。
+ *
+ * @param str UTF-8 字符串。
+ * @return 宽字符串，非法输入时为空。
+ */
+Option<std::wstring> utf8ToWide(std::string_view str);
+
+/**
+ * @brief UTF-16 转 UTF-8。
+ *
+ * @param str UTF-16 字符串。
+ * @return UTF-8 字符串，含有不成对的代理项时为空。
+ */
+Option<std::string> utf16ToUtf8(std::u16string_view str);
+
+/**
+ * @brief UTF-32 转 UTF-8。
+ *
+ * @param str UTF-32 字符串。
+ * @return UTF-8 字符串，含有代理项或超出范围的码点时为空。
+ */
+Option<std::string> utf32ToUtf8(std::u32string_view str);
+
+/**
+ * @brief 宽字符串转 UTF-8。
+ *
+ * @param str 宽字符串。
+ * @return UTF-8 字符串，非法输入时为空。
+ */
+Option<std::string> wideToUtf8(std::wstring_view str);
+
+#endif // TBS_TOOL_LIB_BASE_INCLUDE_TBS_STRINGS_UTF_H
@@ -5,12 +5,21 @@
 #ifndef TBS_CPP_TIME_UTILS_HPP
 #define TBS_CPP_TIME_UTILS_HPP
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <sstream>
 #include <iomanip>
 #include <tbs/defs.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TBS_TIME_TSC 1
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
 namespace time_utils
 {
     /**
@@ -52,6 +61,40 @@ namespace time_utils
         return std::chrono::duration_cast<standard_time>(std::chrono::system_clock::now().time_since_epoch()).count();
     }
 
+    /**
+     * 获取粗粒度的当前时间戳（毫秒），比 utils_now 快得多，适合日志等高频但不要求精确的场合
+     *
+     * Linux 上读取 CLOCK_REALTIME_COARSE（由内核在时钟中断中更新，经 vDSO 读取，不陷入内核），
+     * 精度为一个时钟节拍（通常 1~4 毫秒）；其他平台退化为 utils_now。
+     * @return
+     */
+    inline timeUnit utils_now_coarse()
+    {
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        return static_cast<timeUnit>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+#else
+        return std::chrono::duration_cast<standard_time>(std::chrono::system_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * 线程安全地把 time_t 转换为本地时间（std::localtime 返回共享的静态缓冲区，不是线程安全的）
+     * @param t
+     * @return
+     */
+    inline tm localTime(time_t t)
+    {
+        tm result{};
+#ifdef _WIN32
+        localtime_s(&result, &t);
+#else
+        localtime_r(&t, &result);
+#endif
+        return result;
+    }
+
     /**
      * 将给定的时间单位转换为指定类型的持续时间，并返回其数值表示。
      *
@@ -76,8 +119,8 @@ namespace time_utils
     static DateTime getDateTime(timeUnit tus)
     {
         time_t tms = std::chrono::system_clock::to_time_t(std::chrono::time_point<std::chrono::system_clock>(ms(tus)));
-        tm *t = localtime(&tms);
-        return DateTime((t->tm_year) + 1900, t->tm_mon + 1, t->tm_mday, t->tm_hour, t->tm_min, t->tm_sec, tus % 1000);
+        tm t = localTime(tms);
+        return DateTime(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec, tus % 1000);
     }
 
     /**
@@ -112,11 +155,365 @@ namespace time_utils
     {
         time_t tms = std::chrono::system_clock::to_time_t(
             std::chrono::time_point<std::chrono::system_clock>(standard_time(t)));
+        tm local = localTime(tms);
         std::stringstream ss;
-        ss << std::put_time(std::localtime(&tms), format);
+        ss << std::put_time(&local, format);
         return ss.str();
     }
 
+    /**
+     * 线程安全的时间戳格式化器，输出 "<按 format 格式化到秒>.<3 位毫秒>"
+     *
+     * 同一秒内的时间戳只有毫秒不同，因此格式化器缓存最近一秒的前缀，命中时只改写毫秒。
+     * 缓存以序列锁保护：读者无锁地复制前缀并校验序号，未命中时用线程安全的 localTime + strftime
+     * 重新生成并尝试发布，发布失败（其他线程正在写）也不影响本次输出。
+     */
+    class TimestampFormatter
+    {
+    public:
+        /**
+         * 格式化到秒的前缀的最大字节数（含结尾的 '\0'），超出时 format 返回 0
+         */
+        constexpr static size_t MAX_PREFIX = 56;
+
+        /**
+         * 输出的最大字节数（前缀、'.'、3 位毫秒与结尾的 '\0'）
+         */
+        constexpr static size_t MAX_LENGTH = MAX_PREFIX + 5;
+
+        /**
+         * @param format 精确到秒的 strftime 格式，默认：年-月-日 时:分:秒
+         */
+        explicit TimestampFormatter(CONST char *format = "%Y-%m-%d %H:%M:%S") : m_format(format)
+        {
+            for (auto &w : m_words)
+            {
+                w.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        DELETE_COPY_CONSTRUCTION(TimestampFormatter)
+        DELETE_COPY_ASSIGNMENT(TimestampFormatter)
+
+        /**
+         * 格式化时间戳，写入以 '\0' 结尾的字符串
+         * @param t 时间戳，单位毫秒
+         * @param buf 输出缓冲区
+         * @param size 缓冲区大小，不小于 MAX_LENGTH 时保证不截断
+         * @return 写入的字符数（不含 '\0'），缓冲区不足时为 0
+         */
+        size_t format(timeUnit t, char *buf, size_t size) const
+        {
+            timeUnit second = t >= 0 ? t / 1000 : (t - 999) / 1000;
+            int millis = static_cast<int>(t - second * 1000);
+            char prefix[MAX_PREFIX];
+            size_t len = cached(second, prefix);
+            if (len == 0)
+            {
+                tm local = localTime(static_cast<time_t>(second));
+                len = std::strftime(prefix, MAX_PREFIX, m_format, &local);
+                if (len == 0)
+                {
+                    return 0;
+                }
+                publish(second, prefix, len);
+            }
+            if (size < len + 5)
+            {
+                return 0;
+            }
+            std::memcpy(buf, prefix, len);
+            buf[len] = '.';
+            buf[len + 1] = static_cast<char>('0' + millis / 100);
+            buf[len + 2] = static_cast<char>('0' + millis / 10 % 10);
+            buf[len + 3] = static_cast<char>('0' + millis % 10);
+            buf[len + 4] = '\0';
+            return len + 4;
+        }
+
+        /**
+         * 格式化时间戳
+         * @param t 时间戳，单位毫秒
+         * @return
+         */
+        tbs::str_type format(timeUnit t) const
+        {
+            char buf[MAX_LENGTH];
+            return tbs::str_type(buf, format(t, buf, sizeof(buf)));
+        }
+
+        /**
+         * 默认格式（年-月-日 时:分:秒.毫秒）的共享格式化器
+         * @return
+         */
+        static TimestampFormatter &standard()
+        {
+            static TimestampFormatter formatter;
+            return formatter;
+        }
+
+    private:
+        constexpr static size_t WORDS = MAX_PREFIX / sizeof(uint64_t);
+
+        /**
+         * 读取缓存的前缀，命中时返回长度，否则返回 0
+         */
+        size_t cached(timeUnit second, char *prefix) const
+        {
+            uint64_t seq = m_seq.load(std::memory_order_acquire);
+            if ((seq & 1) != 0 || m_second.load(std::memory_order_relaxed) != second)
+            {
+                return 0;
+            }
+            size_t len = m_length.load(std::memory_order_relaxed);
+            uint64_t words[WORDS];
+            for (size_t i = 0; i < WORDS; i++)
+            {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_seq.load(std::memory_order_relaxed) != seq)
+            {
+                return 0;
+            }
+            std::memcpy(prefix, words, len);
+            return len;
+        }
+
+        void publish(timeUnit second, CONST char *prefix, size_t len) const
+        {
+            uint64_t seq = m_seq.load(std::memory_order_relaxed);
+            // 只有一个写者能把序号从偶数改为奇数，抢不到就放弃本次缓存
+            if ((seq & 1) != 0 || !m_seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire))
+            {
+                return;
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            uint64_t words[WORDS] = {};
+            std::memcpy(words, prefix, len);
+            for (size_t i = 0; i < WORDS; i++)
+            {
+                m_words[i].store(words[i], std::memory_order_relaxed);
+            }
+            m_length.store(len, std::memory_order_relaxed);
+            m_second.store(second, std::memory_order_relaxed);
+            m_seq.store(seq + 2, std::memory_order_release);
+        }
+
+        CONST char *m_format;
+        mutable std::atomic<uint64_t> m_seq{0};
+        mutable std::atomic<timeUnit> m_second{INT64_MIN};
+        mutable std::atomic<size_t> m_length{0};
+        mutable std::atomic<uint64_t> m_words[WORDS];
+    };
+
+
+    /**
+     * 基于 CPU 时间戳计数器（TSC）的高精度单调时钟，用于测量微秒级以下的延迟
+     *
+     * x86 上若 CPU 声明了恒定速率的 TSC（invariant TSC），now() 直接读取 rdtsc（约 7 ns），
+     * 首次换算时用 steady_clock 校准一次频率（约 10 ms）；否则退化为 steady_clock 的纳秒计数，
+     * 此时 1 tick = 1 ns。tick 只在同一进程内可比较，需要时用 toNanos 换算为纳秒。
+     */
+    class CycleClock
+    {
+    public:
+        /**
+         * 读取当前 tick，不保证与前面的指令有序，适合作为计时起点
+         * @return
+         */
+        static uint64_t now()
+        {
+#ifdef TBS_TIME_TSC
+            if (calibration().useTsc)
+            {
+                return __rdtsc();
+            }
+#endif
+            return steadyNanos();
+        }
+
+        /**
+         * 读取当前 tick，rdtscp 会等待前面的指令执行完毕，适合作为计时终点
+         * @return
+         */
+        static uint64_t nowOrdered()
+        {
+#ifdef TBS_TIME_TSC
+            if (calibration().useTsc)
+            {
+                unsigned int aux;
+                return __rdtscp(&aux);
+            }
+#endif
+            return steadyNanos();
+        }
+
+        /**
+         * 把 tick 差换算为纳秒
+         * @param ticks
+         * @return
+         */
+        static uint64_t toNanos(uint64_t ticks)
+        {
+            return static_cast<uint64_t>(static_cast<double>(ticks) * calibration().nanosPerTick);
+        }
+
+        /**
+         * 当前时刻的纳秒数，起点任意，只用于求差
+         * @return
+         */
+        static uint64_t nowNanos()
+        {
+            return toNanos(now());
+        }
+
+        /**
+         * 是否在使用 TSC（否则为 steady_clock）
+         * @return
+         */
+        static bool usingTsc()
+        {
+            return calibration().useTsc;
+        }
+
+        /**
+         * 每秒的 tick 数
+         * @return
+         */
+        static double ticksPerSecond()
+        {
+            return 1e9 / calibration().nanosPerTick;
+        }
+
+        /**
+         * 立即完成校准，避免首次计时时付出校准的开销
+         */
+        static void calibrate()
+        {
+            (void)calibration();
+        }
+
+    private:
+        struct Calibration
+        {
+            bool useTsc = false;
+            double nanosPerTick = 1.0;
+        };
+
+        static uint64_t steadyNanos()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        static CONST Calibration &calibration()
+        {
+            static CONST Calibration c = []()
+            {
+                Calibration r;
+#ifdef TBS_TIME_TSC
+                unsigned int eax, ebx, ecx, edx;
+                // CPUID 0x80000007 EDX 第 8 位：TSC 以恒定速率运行，且不随 C 状态停止
+                if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8)) != 0)
+                {
+                    auto s0 = std::chrono::steady_clock::now();
+                    uint64_t t0 = __rdtsc();
+                    auto s1 = s0;
+                    while (s1 - s0 < std::chrono::milliseconds(10))
+                    {
+                        s1 = std::chrono::steady_clock::now();
+                    }
+                    uint64_t t1 = __rdtsc();
+                    double nanos = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(s1 - s0).count());
+                    if (t1 > t0)
+                    {
+                        r.useTsc = true;
+                        r.nanosPerTick = nanos / static_cast<double>(t1 - t0);
+                    }
+                }
+#endif
+                return r;
+            }();
+            return c;
+        }
+    };
+
+    /**
+     * 秒表：构造时开始计时，开销为两次 tick 读取（TSC 下共约 20~30 个时钟周期）
+     */
+    class Stopwatch
+    {
+    public:
+        Stopwatch() : m_start(CycleClock::now())
+        {
+        }
+
+        /**
+         * 重新开始计时
+         */
+        void restart()
+        {
+            m_start = CycleClock::now();
+        }
+
+        /**
+         * 已经过的 tick 数
+         * @return
+         */
+        [[nodiscard]] uint64_t elapsedTicks() const
+        {
+            return CycleClock::nowOrdered() - m_start;
+        }
+
+        /**
+         * 已经过的纳秒数
+         * @return
+         */
+        [[nodiscard]] uint64_t elapsedNanos() const
+        {
+            return CycleClock::toNanos(elapsedTicks());
+        }
+
+        /**
+         * 已经过的时长
+         * @tparam D std::chrono 时长类型
+         * @return
+         */
+        template <class D = std::chrono::nanoseconds>
+        [[nodiscard]] D elapsed() const
+        {
+            return std::chrono::duration_cast<D>(std::chrono::nanoseconds(elapsedNanos()));
+        }
+
+    private:
+        uint64_t m_start;
+    };
+
+    /**
+     * 作用域计时器：析构时把作用域内经过的纳秒数交给回调，例如 ScopedTimer t([&](uint64_t ns) { hist.add(ns); });
+     * @tparam F 回调类型，签名为 void(uint64_t)
+     */
+    template <typename F>
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(F f) : m_f(std::move(f))
+        {
+        }
+
+        DELETE_COPY_CONSTRUCTION(ScopedTimer)
+        DELETE_COPY_ASSIGNMENT(ScopedTimer)
+
+        ~ScopedTimer()
+        {
+            m_f(m_watch.elapsedNanos());
+        }
+
+    private:
+        F m_f;
+        Stopwatch m_watch;
+    };
+
 }
 
 #endif // TBS_CPP_TIME_UTILS_HPP
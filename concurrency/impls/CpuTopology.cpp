@@ -0,0 +1,170 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#include <tbs/threads/CpuTopology.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace tbs::threads
+{
+    namespace
+    {
+        bool readFile(CONST std::string& path, std::string& out)
+        {
+            std::ifstream in(path);
+            if (!in)
+            {
+                return false;
+            }
+            std::getline(in, out);
+            return true;
+        }
+
+        /**
+         * 进程当前允许运行的 CPU
+         */
+        std::vector<int> allowedCpus()
+        {
+            std::vector<int> cpus;
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            {
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                {
+                    if (CPU_ISSET(cpu, &set))
+                    {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#endif
+            if (cpus.empty())
+            {
+                for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); cpu++)
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            return cpus;
+        }
+    } // namespace
+
+    CONST CpuTopology& CpuTopology::system()
+    {
+        static CONST CpuTopology topology = []()
+        {
+            CpuTopology t;
+            std::vector<int> allowed = allowedCpus();
+            std::string online;
+            if (readFile("/sys/devices/system/node/online", online))
+            {
+                for (int id : parseCpuList(online))
+                {
+                    std::string list;
+                    if (!readFile("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist", list))
+                    {
+                        continue;
+                    }
+                    NumaNode node{id, {}};
+                    std::vector<int> cpus = parseCpuList(list);
+                    std::set_intersection(cpus.begin(), cpus.end(), allowed.begin(), allowed.end(), std::back_inserter(node.cpus));
+                    if (!node.cpus.empty())
+                    {
+                        t._nodes.push_back(std::move(node));
+                    }
+                }
+            }
+            if (t._nodes.empty())
+            {
+                t._nodes.push_back(NumaNode{0, std::move(allowed)});
+            }
+            return t;
+        }();
+        return topology;
+    }
+
+    bool CpuTopology::pinCurrentThread(CONST std::vector<int>& cpus)
+    {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+        {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        return CPU_COUNT(&set) != 0 && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    int CpuTopology::nodeOf(int cpu) CONST
+    {
+        for (CONST auto& node : _nodes)
+        {
+            if (std::binary_search(node.cpus.begin(), node.cpus.end(), cpu))
+            {
+                return node.id;
+            }
+        }
+        return -1;
+    }
+
+    std::vector<int> CpuTopology::parseCpuList(std::string_view list)
+    {
+        std::vector<int> cpus;
+        while (!list.empty())
+        {
+            size_t comma = list.find(',');
+            std::string_view item = list.substr(0, comma);
+            list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+            while (!item.empty() && std::isspace(static_cast<unsigned char>(item.front())))
+            {
+                item.remove_prefix(1);
+            }
+            while (!item.empty() && std::isspace(static_cast<unsigned char>(item.back())))
+            {
+                item.remove_suffix(1);
+            }
+            if (item.empty())
+            {
+                continue;
+            }
+            size_t dash = item.find('-');
+            int first = 0, last = 0;
+            auto a = std::from_chars(item.data(), item.data() + (dash == std::string_view::npos ? item.size() : dash), first);
+            if (a.ec != std::errc())
+            {
+                continue;
+            }
+            last = first;
+            if (dash != std::string_view::npos && std::from_chars(item.data() + dash + 1, item.data() + item.size(), last).ec != std::errc())
+            {
+                continue;
+            }
+            for (int cpu = first; cpu <= last; cpu++)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        std::sort(cpus.begin(), cpus.end());
+        cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+        return cpus;
+    }
+} // namespace tbs::threads
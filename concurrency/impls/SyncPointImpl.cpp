@@ -3,15 +3,17 @@
 #include <cstddef>
 #include "SyncPointImpl_impls.cpp"
 
+template void pooled_resetor<tbs::concurrency::sync_point::SyncPointImpl>(tbs::concurrency::sync_point::SyncPointImpl*&);
+
 namespace tbs::concurrency::sync_point
 {
 
     size_t SyncPoint::waitingCount() const
     {
-        return getImpl()._wait_count - getImpl()._waiting_mutexs.size();
+        return getImpl()._wait_count - getImpl()._free_count;
     }
 
-    SyncPoint::SyncPoint(CONST size_t& wait_count) : PointerImpl(new SyncPointImpl(wait_count))
+    SyncPoint::SyncPoint(CONST size_t& wait_count) : PointerImpl(ThreadCachingObjectPool<SyncPointImpl>::acquire(wait_count))
     {
         getImpl().init();
     }
@@ -88,7 +90,7 @@ namespace tbs::concurrency::sync_point
     {
         for (int i = 0; i < getImpl()._wait_count; i++)
         {
-            getImpl()._conditions[i].notify_one();
+            getImpl()._slots[i].condition.notify_one();
         }
     }
 } // namespace tbs::concurrency::sync_point
@@ -5,35 +5,54 @@
 
 #ifndef SYNCPOINTIMPL_H
 #define SYNCPOINTIMPL_H
+#include <array>
 #include <atomic>
+#include <memory>
 #include <tbs/concurrency/sync_point/SyncPoint.h>
 namespace tbs::concurrency::sync_point
 {
     class SyncPointImpl
     {
     public:
+        /**
+         * 一个等待名额的互斥锁与条件变量，下标为 _wait_count 的名额用于保护空闲名额链表。
+         */
+        struct Slot
+        {
+            std::mutex mutex;
+            std::condition_variable condition;
+            size_t nextFree = 0; // 空闲链表中的下一个名额
+        };
+
+        /**
+         * 内联存放的等待名额数，不超过它时构造不访问全局分配器，覆盖各并发容器的默认等待数。
+         */
+        constexpr static size_t INLINE_WAIT_COUNT = 4;
+
         /**
          * 原子整型 _flag 用于在不同线程间共享状态。
          */
         std::atomic_int _flag{0};
         size_t _wait_count;
 
-        /**
-         * 互斥锁 _mutexs 用于保护共享资源，避免数据竞争。
-         */
-        std::vector<std::mutex> _mutexs;
+        std::array<Slot, INLINE_WAIT_COUNT + 1> _inline_slots;
+        std::unique_ptr<Slot[]> _heap_slots; // 等待数超过 INLINE_WAIT_COUNT 时才分配
 
         /**
-         * 条件变量 _conditions 用于线程间的通信，提高同步效率。
+         * 正在使用的名额，指向 _inline_slots 或 _heap_slots。
          */
-        std::vector<std::condition_variable> _conditions;
+        Slot* _slots;
 
         /**
-         * _waiting_mutexs 用于管理等待的互斥锁索引。
+         * 空闲名额链表，由 _slots[_wait_count].mutex 保护；_free_count 可以不加锁读取。
          */
-        std::queue<size_t> _waiting_mutexs;
+        size_t _free_head = 0;
+        std::atomic_size_t _free_count{0};
 
-        explicit SyncPointImpl(const size_t& wait_count = 1) : _wait_count{wait_count}, _mutexs{wait_count + 1}, _conditions{wait_count + 1}
+        explicit SyncPointImpl(const size_t& wait_count = 1) :
+            _wait_count{wait_count},
+            _heap_slots{wait_count > INLINE_WAIT_COUNT ? std::make_unique<Slot[]>(wait_count + 1) : nullptr},
+            _slots{_heap_slots ? _heap_slots.get() : _inline_slots.data()}
         {
         }
 
@@ -41,10 +60,17 @@ namespace tbs::concurrency::sync_point
         {
             for (size_t i = 0; i < _wait_count; ++i)
             {
-                _waiting_mutexs.push(i);
+                _push_free(i);
             }
         }
 
+        void _push_free(const size_t& i)
+        {
+            _slots[i].nextFree = _free_head;
+            _free_head = i;
+            ++_free_count;
+        }
+
         void timeLimitWait(const time_utils::ms& ms,
                            __predic_functional predic,
                            const bool& flagCheck,
@@ -55,7 +81,7 @@ namespace tbs::concurrency::sync_point
                            bool& r,
                            std::unique_lock<std::mutex>& lock)
         {
-            r = _conditions[i].wait_for(lock,
+            r = _slots[i].condition.wait_for(lock,
                                         time_utils::ms(ms),
                                         [&]()
                                         {
@@ -66,7 +92,7 @@ namespace tbs::concurrency::sync_point
         }
         void predictWait(__predic_functional predic, const bool& flagCheck, const int& target, const size_t& i, bool& pred, bool& flag_c, std::unique_lock<std::mutex>& lock)
         {
-            _conditions[i].wait(lock,
+            _slots[i].condition.wait(lock,
                                 [&]()
                                 {
                                     pred = predic();
@@ -86,7 +112,7 @@ namespace tbs::concurrency::sync_point
             bool pred = false;
             bool flag_c = false;
             bool r = false;
-            std::unique_lock<std::mutex> lock(_mutexs[i]);
+            std::unique_lock<std::mutex> lock(_slots[i].mutex);
             if (timeLimited)
             {
                 timeLimitWait(ms, predic, flagCheck, target, i, pred, flag_c, r, lock);
@@ -107,19 +133,21 @@ namespace tbs::concurrency::sync_point
                 wait_impl(ms, sp, predic, flagCheck, target, timeLimited, m, i);
             }
             {
-                std::unique_lock<std::mutex> threadLock(_mutexs[_wait_count]);
-                _waiting_mutexs.push(i);
+                std::unique_lock<std::mutex> threadLock(_slots[_wait_count].mutex);
+                _push_free(i);
             }
-            _conditions[_wait_count].notify_one();
+            _slots[_wait_count].condition.notify_one();
         }
 
         size_t _lock_mutex()
         {
-            _conditions[_wait_count].notify_one();
-            std::unique_lock<std::mutex> lock(_mutexs[_wait_count]);
-            _conditions[_wait_count].wait(lock, [&]() { return !_waiting_mutexs.empty(); });
-            const size_t r = _waiting_mutexs.front();
-            _waiting_mutexs.pop();
+            Slot& guard = _slots[_wait_count];
+            guard.condition.notify_one();
+            std::unique_lock<std::mutex> lock(guard.mutex);
+            guard.condition.wait(lock, [&]() { return _free_count != 0; });
+            const size_t r = _free_head;
+            _free_head = _slots[r].nextFree;
+            --_free_count;
             return r;
         }
     };
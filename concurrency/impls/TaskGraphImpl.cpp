@@ -0,0 +1,303 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#include <tbs/threads/TaskGraph.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace tbs::threads
+{
+    class TaskGraphImpl
+    {
+    private:
+        constexpr static size_t NONE = SIZE_MAX; // 没有节点
+
+        struct Node
+        {
+            std::function<void()> task;
+            int priority = 0;
+            uint32_t predecessors = 0; // 前驱数
+            std::vector<size_t> successors{}; // 后继节点
+        };
+
+        ThreadPool& _pool;
+        std::vector<Node> _nodes;
+        std::vector<size_t> _roots; // 没有前驱的节点，检查环时得出
+        std::unique_ptr<std::atomic_uint32_t[]> _pending; // 各节点尚未完成的前驱数，每次运行前重置
+        size_t _pendingSize = 0;
+        bool _validated = false; // 图在上次检查后是否未被修改
+
+        std::atomic_bool _running{false};
+        std::atomic_size_t _remaining{0}; // 本次运行尚未结束的节点数
+        std::atomic_bool _failed{false}; // 是否已有节点抛出异常
+        std::exception_ptr _error; // 第一个异常，由 _mutex 保护
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        bool _done = false; // 本次运行是否已结束，由 _mutex 保护
+
+        void checkIdle() CONST
+        {
+            if (_running)
+            {
+                throw std::logic_error("TaskGraph is running");
+            }
+        }
+
+        /**
+         * 按拓扑序检查环，记录根节点，按需扩大计数器
+         */
+        void validate()
+        {
+            std::vector<uint32_t> indegree(_nodes.size());
+            std::vector<size_t> order;
+            order.reserve(_nodes.size());
+            for (size_t i = 0; i < _nodes.size(); i++)
+            {
+                indegree[i] = _nodes[i].predecessors;
+                if (indegree[i] == 0)
+                {
+                    order.push_back(i);
+                }
+            }
+            _roots = order;
+            for (size_t k = 0; k < order.size(); k++)
+            {
+                for (size_t s : _nodes[order[k]].successors)
+                {
+                    if (--indegree[s] == 0)
+                    {
+                        order.push_back(s);
+                    }
+                }
+            }
+            if (order.size() != _nodes.size())
+            {
+                throw std::invalid_argument("TaskGraph contains a cycle");
+            }
+            if (_pendingSize < _nodes.size())
+            {
+                _pending = std::make_unique<std::atomic_uint32_t[]>(_nodes.size());
+                _pendingSize = _nodes.size();
+            }
+            _validated = true;
+        }
+
+        /**
+         * 把就绪的节点提交到线程池，任务只捕获 this 与下标，放得进 std::function 的内联存储
+         * @return 是否已交给线程池，被拒绝时由调用者在当前线程上执行
+         */
+        bool dispatch(size_t i)
+        {
+            try
+            {
+                return _pool.submit([this, i]() { execute(i); }, _nodes[i].priority) >= 0;
+            }
+            catch (std::runtime_error&)
+            {
+                return false;
+            }
+        }
+
+        /**
+         * 执行节点，并沿着就绪的后继继续执行：第一个就绪的后继留在本线程，其余提交到线程池
+         */
+        void execute(size_t first)
+        {
+            std::vector<size_t> overflow; // 线程池拒绝、改在本线程上执行的节点，只在被拒绝时分配
+            size_t next = first;
+            while (next != NONE || !overflow.empty())
+            {
+                if (next == NONE)
+                {
+                    next = overflow.back();
+                    overflow.pop_back();
+                }
+                size_t current = next;
+                next = NONE;
+                runBody(current);
+                for (size_t s : _nodes[current].successors)
+                {
+                    if (_pending[s].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    {
+                        continue;
+                    }
+                    if (next == NONE)
+                    {
+                        next = s;
+                    }
+                    else if (!dispatch(s))
+                    {
+                        overflow.push_back(s);
+                    }
+                }
+                // 最后一个节点结束后 run 可能立即返回，此后只能访问局部变量
+                finishOne();
+            }
+        }
+
+        void runBody(size_t i)
+        {
+            if (_failed.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            try
+            {
+                _nodes[i].task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> g(_mutex);
+                if (!_error)
+                {
+                    _error = std::current_exception();
+                }
+                _failed = true;
+            }
+        }
+
+        void finishOne()
+        {
+            if (_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+            std::lock_guard<std::mutex> g(_mutex);
+            _done = true;
+            _cv.notify_all();
+        }
+
+    public:
+        explicit TaskGraphImpl(ThreadPool& pool) : _pool(pool)
+        {
+        }
+
+        size_t addNode(std::function<void()> task, int priority)
+        {
+            checkIdle();
+            _nodes.push_back(Node{std::move(task), priority});
+            _validated = false;
+            return _nodes.size() - 1;
+        }
+
+        void addEdge(size_t from, size_t to)
+        {
+            checkIdle();
+            if (from >= _nodes.size() || to >= _nodes.size())
+            {
+                throw std::invalid_argument("TaskGraph: node id out of range");
+            }
+            if (from == to)
+            {
+                throw std::invalid_argument("TaskGraph: a node cannot depend on itself");
+            }
+            _nodes[from].successors.push_back(to);
+            _nodes[to].predecessors++;
+            _validated = false;
+        }
+
+        void run()
+        {
+            if (_running.exchange(true))
+            {
+                throw std::logic_error("TaskGraph is running");
+            }
+            try
+            {
+                if (!_validated)
+                {
+                    validate();
+                }
+                if (_nodes.empty())
+                {
+                    _running = false;
+                    return;
+                }
+                if (!_pool.isRunning())
+                {
+                    throw std::runtime_error("ThreadPool is not running");
+                }
+            }
+            catch (...)
+            {
+                _running = false;
+                throw;
+            }
+            for (size_t i = 0; i < _nodes.size(); i++)
+            {
+                _pending[i].store(_nodes[i].predecessors, std::memory_order_relaxed);
+            }
+            _failed = false;
+            _error = nullptr;
+            _done = false;
+            _remaining.store(_nodes.size(), std::memory_order_release);
+            for (size_t root : _roots)
+            {
+                if (!dispatch(root))
+                {
+                    execute(root);
+                }
+            }
+            std::exception_ptr error;
+            {
+                std::unique_lock<std::mutex> l(_mutex);
+                _cv.wait(l, [this]() { return _done; });
+                error = std::exchange(_error, nullptr);
+            }
+            _running = false;
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        size_t size() CONST
+        {
+            return _nodes.size();
+        }
+    };
+} // namespace tbs::threads
+
+template <>
+void default_resetor<tbs::threads::TaskGraphImpl>(tbs::threads::TaskGraphImpl*& ptr)
+{
+    delete ptr;
+    ptr = nullptr;
+}
+
+namespace tbs::threads
+{
+    TaskGraph::TaskGraph(ThreadPool& pool) : PointerImpl(pool)
+    {
+    }
+
+    TaskGraph::~TaskGraph() = default;
+
+    size_t TaskGraph::addNode(std::function<void()> task, int priority)
+    {
+        return getImpl().addNode(std::move(task), priority);
+    }
+
+    void TaskGraph::addEdge(size_t from, size_t to)
+    {
+        getImpl().addEdge(from, to);
+    }
+
+    void TaskGraph::run()
+    {
+        getImpl().run();
+    }
+
+    size_t TaskGraph::size() const
+    {
+        return getImpl().size();
+    }
+} // namespace tbs::threads
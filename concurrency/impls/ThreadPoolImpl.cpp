@@ -3,10 +3,18 @@
 //
 
 #include <tbs/threads/ThreadPool.h>
+#include <tbs/threads/Coroutine.h>
 
 #include <utility>
 #include "ThreadPoolImpl_impls.cpp"
 
+template <>
+void default_resetor<tbs::threads::ThreadPoolImpl>(tbs::threads::ThreadPoolImpl*& ptr)
+{
+    delete ptr;
+    ptr = nullptr;
+}
+
 
 namespace tbs::threads
 {
@@ -14,6 +22,14 @@ namespace tbs::threads
     {
         return getImpl().config().running;
     }
+    ScheduleAwaiter ThreadPool::schedule(int priority)
+    {
+        return ScheduleAwaiter(*this, priority);
+    }
+    ThreadPoolSnapshot ThreadPool::snapshot() const
+    {
+        return getImpl().snapshot();
+    }
     const ThreadPoolData& ThreadPool::getConfig() const
     {
         return getImpl().config();
@@ -36,13 +52,35 @@ namespace tbs::threads
         PointerImpl(ThreadPoolData{threadPoolName, threadCount, maxTaskCount, false, std::move(exceptionHandler), std::move(eventHandler), maxIdleThreadCount, maxIdleTime}, this)
     {
     }
+    ThreadPool::~ThreadPool() = default;
+
     void ThreadPool::stop()
     {
         getImpl().stop();
     }
-    void ThreadPool::submit(std::function<void()> f, int priority)
+    int ThreadPool::submit(std::function<void()> f, int priority)
+    {
+        return getImpl().addTask(ThreadTask{std::move(f), ThreadTask::CREATED, priority}, true);
+    }
+    int ThreadPool::submit(std::function<void()> f, CancellationToken token, int priority)
+    {
+        return getImpl().addTask(ThreadTask{std::move(f), ThreadTask::CREATED, priority, std::move(token)}, true);
+    }
+    int ThreadPool::trySubmit(std::function<void()> f, int priority)
+    {
+        return getImpl().addTask(ThreadTask{std::move(f), ThreadTask::CREATED, priority}, false);
+    }
+    int ThreadPool::trySubmit(std::function<void()> f, CancellationToken token, int priority)
+    {
+        return getImpl().addTask(ThreadTask{std::move(f), ThreadTask::CREATED, priority, std::move(token)}, false);
+    }
+    int ThreadPool::submitToNode(int node, std::function<void()> f, int priority)
+    {
+        return getImpl().addTask(ThreadTask{std::move(f), ThreadTask::CREATED, priority}, true, node);
+    }
+    int ThreadPool::submitToNode(int node, std::function<void()> f, CancellationToken token, int priority)
     {
-        getImpl().addTask(ThreadTask{f, ThreadTask::CREATED, priority});
+        return getImpl().addTask(ThreadTask{std::move(f), ThreadTask::CREATED, priority, std::move(token)}, true, node);
     }
 
 } // namespace tbs::threads
@@ -5,9 +5,17 @@
 
 #ifndef THREADPOOL_THREADPOOLIMPL_IMPLS_H
 #define THREADPOOL_THREADPOOLIMPL_IMPLS_H
+#include <climits>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <tbs/concurrency/adapters.h>
+#include <tbs/concurrency/containers/ConcurrentAgingQueue.h>
 #include <tbs/concurrency/containers/ConcurrentPriorityQueue.h>
 #include <tbs/log/loggers/BuiltInLogger.h>
+#include <tbs/threads/CpuTopology.h>
 #include <tbs/threads/ThreadPool.h>
 namespace tbs::threads
 {
@@ -21,24 +29,81 @@ namespace tbs::threads
 #define LOGGER_WRAPPER g
 #include <tbs/log/log_macro.h>
 
+    /**
+     * 单个工作线程的指标
+     * 提交者与本线程写入的字段分处不同缓存行，本线程独写的字段只做 relaxed 读写，不需要原子读改写
+     */
+    struct WorkerStats
+    {
+        alignas(64) std::atomic_uint64_t submitted{0}; // 由提交者累加
+        std::atomic_uint64_t rejected{0}; // 由提交者累加
+        std::atomic_uint64_t enqueued{0}; // 入队次数，含唤醒用的空任务
+        std::atomic_uint64_t dequeued{0}; // 出队次数，含被窃取和被淘汰的
+        alignas(64) std::atomic_uint64_t completed{0}; // 只由本线程写
+        std::atomic_uint64_t busySince{0}; // 当前任务开始执行时的 CycleClock 读数，空闲时为 0；只由本线程写
+        std::atomic_uint64_t stolen{0}; // 只由本线程写
+        LatencyHistogram queueWait; // 只由本线程写
+        LatencyHistogram runTime; // 只由本线程写
+    };
+
+    /**
+     * 单写者计数加一
+     */
+    inline void bump(std::atomic_uint64_t& c)
+    {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * 两次 CycleClock 读数之间的纳秒数，跨核读数倒挂时为 0
+     */
+    inline uint64_t elapsedNanos(uint64_t from, uint64_t to)
+    {
+        return to > from ? time_utils::CycleClock::toNanos(to - from) : 0;
+    }
+
+    class ThreadPoolImpl;
+
+    /**
+     * 当前线程所属的线程池，不是工作线程时为空
+     */
+    thread_local CONST ThreadPoolImpl* currentPool = nullptr;
+
     class ThreadPoolImpl
     {
     private:
         ThreadPoolData _config;
         std::unordered_map<size_t, std::thread> _threads;
         std::vector<tbs::concurrency::containers::ConcurrentPriorityQueue<ThreadTask>> _tasks;
+        std::vector<tbs::concurrency::containers::ConcurrentAgingQueue<ThreadTask>> _agingTasks; // 开启优先级老化后才创建
+        bool _aging = false; // 是否使用 _agingTasks，只在没有工作线程时修改
+        std::vector<std::vector<int>> _workerCpus; // 各工作线程绑定的 CPU，为空时不绑定；只在没有工作线程时修改
+        std::unordered_map<int, std::vector<size_t>> _nodeWorkers; // NUMA 节点编号到其上的工作线程
         ThreadPool* _pool;
         std::atomic_size_t _taskCount{0};
+        std::atomic_bool _running{false}; // 工作线程读取的运行标志，_config.running 为其对外的副本
+        std::atomic_size_t _alive{0}; // 仍在访问本对象的工作线程数
+        std::atomic_uint64_t _sequence{0}; // 提交序号
+        std::mutex _slotMutex; // REJECT_POLICY_BLOCK 等待名额用的锁
+        std::condition_variable _slotCv;
+        std::atomic_size_t _slotWaiters{0}; // 阻塞等待名额的提交者数
+        std::unique_ptr<WorkerStats[]> _stats; // 各工作线程的指标，按线程索引
+        size_t _capacity = 0; // 已分配的队列与指标数，即线程数上限；只在没有工作线程时修改
+        size_t _minThreads = 0; // 弹性伸缩的下限，启动时由配置得出
+        size_t _maxThreads = 0; // 弹性伸缩的上限，启动时由配置得出
+        std::atomic_size_t _active{0}; // 接收新任务的线程槽位数，槽位 [0, _active) 连续
+        std::atomic_uint64_t _lastGrow{0}; // 上次扩容的时刻（纳秒）
+        std::thread _monitor; // 扩容监视线程，只在设置了 targetQueueWait 且可以扩容时运行
+        std::mutex _monitorMutex;
+        std::condition_variable _monitorCv;
         SharedMutexLockAdapter locker;
         using lockIt = concurrency::guard::auto_op_lock_guard<SharedMutexLockAdapter>;
 
     public:
         ThreadPoolImpl(CONST ThreadPoolData& config, ThreadPool* pool) : _config{config}, _pool{pool}
         {
-            for (size_t i = 0; i < _config.threadCount; i++)
-            {
-                _tasks.push_back(std::move(tbs::concurrency::containers::ConcurrentPriorityQueue<ThreadTask>()));
-            }
+            reserveWorkers(std::max<size_t>(_config.threadCount, 1));
+            _active = _capacity;
         }
         CONST ThreadPoolData& config() CONST
         {
@@ -48,36 +113,571 @@ namespace tbs::threads
         {
             return _config;
         }
+        ~ThreadPoolImpl()
+        {
+            if (currentPool == this)
+            {
+                // 调用线程在任务返回后还要访问本对象，无法安全析构
+                LOG_ERROR("ThreadPool destroyed on its own worker thread");
+                std::terminate();
+            }
+            // 即使已经停止，也要等在工作线程上调用 stop 后仍在退出的线程
+            stop();
+        }
+
         void stop()
         {
+            _running = false;
             _config.running = false;
-            for (auto& t : _threads)
+            // 工作线程是分离的，不能 join：向仍在运行的线程的队列投递一个已取消的空任务唤醒阻塞在 poll 上的线程，再等它们全部退出
+            {
+                lockIt g(locker);
+                for (CONST auto& [i, t] : _threads)
+                {
+                    // 序号最大、优先级最高，不会被淘汰策略选中
+                    enqueue(i, ThreadTask{[]() {}, ThreadTask::CANCELED, INT_MIN, CancellationToken(), UINT64_MAX});
+                }
+            }
+            {
+                std::lock_guard<std::mutex> g(_slotMutex);
+                _slotCv.notify_all();
+            }
+            std::thread monitor;
+            {
+                std::lock_guard<std::mutex> g(_monitorMutex);
+                monitor = std::move(_monitor);
+                _monitorCv.notify_all();
+            }
+            if (monitor.joinable())
+            {
+                monitor.join();
+            }
+            // 在本线程池的工作线程上调用时，调用者在任务返回后才退出，不计入等待
+            CONST size_t self = currentPool == this ? 1 : 0;
+            while (_alive > self)
             {
-                t.second.join();
+                std::this_thread::sleep_for(time_utils::ms(1));
             }
         }
 
-        void addTask(CONST ThreadTask& task)
+        /**
+         * 提交任务
+         * @param task 任务
+         * @param applyPolicy 队列已满时是否执行 rejectPolicy，为 false 时直接返回 EXCEPTION_TASK_COUNT_FULL
+         * @param node 优先使用的 NUMA 节点，-1 为不指定
+         * @return SUBMIT_ACCEPTED、SUBMIT_CALLER_RAN 或错误码
+         */
+        int addTask(ThreadTask task, bool applyPolicy, int node = -1)
         {
-            if (!_config.running)
+            if (!_running)
             {
+                if (!applyPolicy)
+                {
+                    return EXCEPTION_NOT_RUNNING;
+                }
                 throw std::runtime_error("ThreadPool is not running");
             }
-            size_t tc = ++_taskCount;
-            if (tc >= _config.maxTaskCount * _config.threadCount)
+            task.sequence = _sequence++;
+            if (!acquireSlot())
+            {
+                if (!applyPolicy)
+                {
+                    _stats[task.sequence % _active].rejected.fetch_add(1, std::memory_order_relaxed);
+                    return EXCEPTION_TASK_COUNT_FULL;
+                }
+                switch (_config.rejectPolicy)
+                {
+                    case REJECT_POLICY_BLOCK:
+                        if (!waitSlot())
+                        {
+                            return reject(task);
+                        }
+                        break;
+                    case REJECT_POLICY_CALLER_RUNS:
+                        runInCaller(task);
+                        return SUBMIT_CALLER_RAN;
+                    case REJECT_POLICY_DROP_OLDEST:
+                        // 序号越小越“大”，淘汰最早提交的任务
+                        if (!dropFor(task, [](CONST ThreadTask& a, CONST ThreadTask& b) { return a.sequence > b.sequence; }))
+                        {
+                            return reject(task);
+                        }
+                        break;
+                    case REJECT_POLICY_DROP_LOWEST_PRIORITY:
+                        // 与队列的出队顺序一致，priority 越大越晚执行
+                        if (!dropFor(task, [](CONST ThreadTask& a, CONST ThreadTask& b) { return a.priority < b.priority; }))
+                        {
+                            return reject(task);
+                        }
+                        break;
+                    default:
+                        return reject(task);
+                }
+            }
+            size_t active = _active.load(std::memory_order_relaxed);
+            size_t index = task.sequence % active;
+            if (node >= 0)
+            {
+                auto it = _nodeWorkers.find(node);
+                if (it != _nodeWorkers.end())
+                {
+                    // 只选活跃的槽位，节点上的槽位都未启用时退回普通分配
+                    CONST auto& workers = it->second;
+                    for (size_t k = 0; k < workers.size(); k++)
+                    {
+                        size_t w = workers[(task.sequence + k) % workers.size()];
+                        if (w < active)
+                        {
+                            index = w;
+                            break;
+                        }
+                    }
+                }
+            }
+            task.enqueuedAt = time_utils::CycleClock::now();
+            _stats[index].submitted.fetch_add(1, std::memory_order_relaxed);
+            // 先入队再检查线程：空闲退出的线程在锁内确认队列为空后才注销，两者不会错过对方
+            enqueue(index, task);
+            createEnv(index, index + 1);
+            if (_config.targetQueueWait != 0 && backlogged(index, time_utils::CycleClock::now()))
+            {
+                grow();
+            }
+            return SUBMIT_ACCEPTED;
+        }
+
+        void enqueue(size_t i, CONST ThreadTask& task)
+        {
+            // 先计数再入队，出队计数不会超过入队计数
+            _stats[i].enqueued.fetch_add(1, std::memory_order_relaxed);
+            if (_aging)
+            {
+                _agingTasks[i].push(task, task.priority);
+            }
+            else
+            {
+                _tasks[i].push(task);
+            }
+        }
+
+        std::optional<ThreadTask> dequeue(size_t i, CONST time_utils::ms& timeout)
+        {
+            auto t = _aging ? _agingTasks[i].poll(timeout) : _tasks[i].poll(timeout);
+            if (t.has_value())
+            {
+                _stats[i].dequeued.fetch_add(1, std::memory_order_relaxed);
+            }
+            return t;
+        }
+
+        /**
+         * 不等待地出队，不占用队列的等待名额，可以在队列的工作线程阻塞于 dequeue 时调用
+         */
+        std::optional<ThreadTask> tryDequeue(size_t i)
+        {
+            auto t = _aging ? _agingTasks[i].tryPoll() : _tasks[i].tryPoll();
+            if (t.has_value())
+            {
+                _stats[i].dequeued.fetch_add(1, std::memory_order_relaxed);
+            }
+            return t;
+        }
+
+        /**
+         * 队列中的任务数，由出入队计数得出，不加锁，并发修改时为近似值
+         */
+        uint64_t queueDepth(size_t i) CONST
+        {
+            uint64_t out = _stats[i].dequeued.load(std::memory_order_relaxed);
+            uint64_t in = _stats[i].enqueued.load(std::memory_order_relaxed);
+            return in > out ? in - out : 0;
+        }
+
+        /**
+         * 自己的队列为空时，从其他有积压的队列中窃取一个任务
+         */
+        std::optional<ThreadTask> steal(size_t i)
+        {
+            size_t active = _active.load(std::memory_order_relaxed);
+            if (active < 2 || queueDepth(i) != 0)
+            {
+                return std::nullopt;
+            }
+            for (size_t k = 1; k < active && _running; k++)
+            {
+                size_t j = (i + k) % active;
+                if (queueDepth(j) == 0)
+                {
+                    continue;
+                }
+                auto t = tryDequeue(j);
+                if (!t.has_value())
+                {
+                    continue;
+                }
+                if (t->sequence == UINT64_MAX)
+                {
+                    // stop 投递给线程 j 的唤醒任务，放回去
+                    enqueue(j, t.value());
+                    return std::nullopt;
+                }
+                bump(_stats[i].stolen);
+                return t;
+            }
+            return std::nullopt;
+        }
+
+        ThreadPoolSnapshot snapshot() CONST
+        {
+            ThreadPoolSnapshot s;
+            s.threads = _active.load(std::memory_order_relaxed);
+            s.workers.resize(_capacity);
+            for (size_t i = 0; i < _capacity; i++)
+            {
+                CONST WorkerStats& w = _stats[i];
+                WorkerMetrics& m = s.workers[i];
+                m.submitted = w.submitted.load(std::memory_order_relaxed);
+                m.completed = w.completed.load(std::memory_order_relaxed);
+                m.rejected = w.rejected.load(std::memory_order_relaxed);
+                m.stolen = w.stolen.load(std::memory_order_relaxed);
+                m.queueDepth = queueDepth(i);
+                s.total.submitted += m.submitted;
+                s.total.completed += m.completed;
+                s.total.rejected += m.rejected;
+                s.total.stolen += m.stolen;
+                s.total.queueDepth += m.queueDepth;
+                s.queueWait.merge(w.queueWait.snapshot());
+                s.runTime.merge(w.runTime.snapshot());
+            }
+            return s;
+        }
+
+        bool queueEmpty(size_t i) CONST
+        {
+            return _aging ? _agingTasks[i].empty() : _tasks[i].empty();
+        }
+
+        /**
+         * 按 priorityAgingInterval 选择严格优先级堆或分桶老化队列；切换时把上次运行遗留的任务搬到新队列
+         */
+        void applyScheduling()
+        {
+            bool aging = _config.priorityAgingInterval != 0;
+            if (aging && _agingTasks.empty())
+            {
+                for (size_t i = 0; i < _capacity; i++)
+                {
+                    _agingTasks.emplace_back(time_utils::ms(_config.priorityAgingInterval));
+                }
+            }
+            for (auto& q : _agingTasks)
+            {
+                q.setAgingInterval(time_utils::ms(_config.priorityAgingInterval));
+            }
+            if (aging == _aging)
+            {
+                return;
+            }
+            std::vector<std::vector<ThreadTask>> pending(_capacity);
+            for (size_t i = 0; i < _capacity; i++)
+            {
+                while (auto t = tryDequeue(i))
+                {
+                    pending[i].push_back(std::move(t.value()));
+                }
+            }
+            _aging = aging;
+            for (size_t i = 0; i < _capacity; i++)
+            {
+                for (CONST auto& t : pending[i])
+                {
+                    enqueue(i, t);
+                }
+            }
+        }
+
+        /**
+         * 按 placement 计算每个工作线程绑定的 CPU 以及各 NUMA 节点上的工作线程
+         */
+        void planPlacement()
+        {
+            _workerCpus.assign(_capacity, {});
+            _nodeWorkers.clear();
+            if (_config.placement == PLACEMENT_NONE)
+            {
+                return;
+            }
+            CONST CpuTopology& topology = CpuTopology::system();
+            std::vector<int> allowed = _config.cpuSet;
+            std::sort(allowed.begin(), allowed.end());
+            // 各节点内落在 cpuSet 中的 CPU，cpuSet 为空时不过滤
+            std::vector<NumaNode> nodes;
+            for (CONST auto& node : topology.nodes())
+            {
+                NumaNode n{node.id, {}};
+                for (int cpu : node.cpus)
+                {
+                    if (allowed.empty() || std::binary_search(allowed.begin(), allowed.end(), cpu))
+                    {
+                        n.cpus.push_back(cpu);
+                    }
+                }
+                if (!n.cpus.empty())
+                {
+                    nodes.push_back(std::move(n));
+                }
+            }
+            if (nodes.empty())
+            {
+                LOG_WARN("no usable cpu for placement, workers are not pinned");
+                return;
+            }
+            for (size_t i = 0; i < _capacity; i++)
+            {
+                if (_config.placement == PLACEMENT_CPU_SET)
+                {
+                    for (CONST auto& n : nodes)
+                    {
+                        _workerCpus[i].insert(_workerCpus[i].end(), n.cpus.begin(), n.cpus.end());
+                    }
+                    continue;
+                }
+                CONST NumaNode* node = &nodes[i % nodes.size()];
+                if (_config.placement == PLACEMENT_PACK)
+                {
+                    // 把各节点的 CPU 首尾相接，第 i 个工作线程占用其中第 i 个（循环）
+                    size_t total = 0;
+                    for (CONST auto& n : nodes)
+                    {
+                        total += n.cpus.size();
+                    }
+                    size_t k = i % total;
+                    for (CONST auto& n : nodes)
+                    {
+                        if (k < n.cpus.size())
+                        {
+                            node = &n;
+                            _workerCpus[i] = {n.cpus[k]};
+                            break;
+                        }
+                        k -= n.cpus.size();
+                    }
+                }
+                else
+                {
+                    _workerCpus[i] = node->cpus;
+                }
+                _nodeWorkers[node->id].push_back(i);
+            }
+        }
+
+        /**
+         * 为至少 capacity 个工作线程分配队列和指标，只在没有工作线程时调用
+         */
+        void reserveWorkers(size_t capacity)
+        {
+            if (capacity <= _capacity)
+            {
+                return;
+            }
+            while (_tasks.size() < capacity)
+            {
+                _tasks.emplace_back();
+            }
+            while (!_agingTasks.empty() && _agingTasks.size() < capacity)
+            {
+                _agingTasks.emplace_back(time_utils::ms(_config.priorityAgingInterval));
+            }
+            // 指标不可移动，上限变大时重新分配，之前的计数随之清零
+            _stats = std::make_unique<WorkerStats[]>(capacity);
+            _capacity = capacity;
+        }
+
+        /**
+         * 槽位是否积压：队列非空，且线程正在执行的任务已超过 targetQueueWait，排在它后面的任务至少还要再等
+         * @param i 槽位
+         * @param now CycleClock 读数
+         */
+        bool backlogged(size_t i, uint64_t now) CONST
+        {
+            uint64_t since = _stats[i].busySince.load(std::memory_order_relaxed);
+            return since != 0 && queueDepth(i) != 0 && elapsedNanos(since, now) > _config.targetQueueWait * 1000000;
+        }
+
+        /**
+         * 扩容监视线程：所有工作线程都被长任务占住时没有出队，也就不会按排队时间扩容，
+         * 由它每个 targetQueueWait 周期检查一次各槽位是否积压
+         */
+        void monitor()
+        {
+            std::unique_lock<std::mutex> l(_monitorMutex);
+            while (_running)
+            {
+                _monitorCv.wait_for(l, time_utils::ms(_config.targetQueueWait), [this]() { return !_running; });
+                uint64_t now = time_utils::CycleClock::now();
+                size_t active = _active.load();
+                for (size_t i = 0; _running && i < active; i++)
+                {
+                    if (backlogged(i, now))
+                    {
+                        grow();
+                        break;
+                    }
+                }
+            }
+        }
+
+        /**
+         * 排队时间超过目标时启用一个新槽位，每个 targetQueueWait 周期最多扩容一次，给新线程消化积压的时间
+         * 新线程的队列为空，立即从其他队列窃取积压的任务；之后新任务按新的槽位数分配，不迁移已排队的任务
+         */
+        void grow()
+        {
+            size_t active = _active.load();
+            if (active >= _maxThreads)
+            {
+                return;
+            }
+            uint64_t now = time_utils::CycleClock::nowNanos();
+            uint64_t last = _lastGrow.load();
+            if (now - last < _config.targetQueueWait * 1000000 || !_lastGrow.compare_exchange_strong(last, now))
+            {
+                return;
+            }
+            if (_active.compare_exchange_strong(active, active + 1))
+            {
+                LOG_INFO("grow to {} threads", active + 1);
+                createEnv(active, active + 1);
+            }
+        }
+
+        /**
+         * 空闲线程退出后，从最高的槽位开始收回线程已退出且队列为空的槽位，不低于 minThreads；调用时持有 locker
+         * 提交者可能仍按旧的槽位数向被收回的槽位投递任务，此时 createEnv 会为它重新创建线程，任务不会丢失
+         */
+        void shrink()
+        {
+            size_t active = _active.load();
+            size_t target = active;
+            while (target > _minThreads && !_threads.contains(target - 1) && queueEmpty(target - 1))
+            {
+                target--;
+            }
+            // 与 grow 并发时放弃本次收缩
+            if (target != active && _active.compare_exchange_strong(active, target))
+            {
+                LOG_INFO("shrink to {} threads", target);
+            }
+        }
+
+        /**
+         * 未完成任务数未达上限时占用一个名额
+         */
+        bool acquireSlot()
+        {
+            size_t capacity = _config.maxTaskCount * _active.load(std::memory_order_relaxed);
+            size_t count = _taskCount.load();
+            while (count < capacity)
+            {
+                if (_taskCount.compare_exchange_weak(count, count + 1))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * 任务完成或被丢弃时归还名额，有阻塞中的提交者时唤醒一个
+         */
+        void releaseSlot()
+        {
+            --_taskCount;
+            if (_slotWaiters != 0)
+            {
+                std::lock_guard<std::mutex> g(_slotMutex);
+                _slotCv.notify_one();
+            }
+        }
+
+        /**
+         * 阻塞等待名额，最多等待 rejectTimeout 毫秒
+         */
+        bool waitSlot()
+        {
+            bool acquired = false;
+            auto deadline = std::chrono::steady_clock::now() + time_utils::ms(_config.rejectTimeout);
+            std::unique_lock<std::mutex> l(_slotMutex);
+            ++_slotWaiters;
+            _slotCv.wait_until(l, deadline, [&]() { return !_running || (acquired = acquireSlot()); });
+            --_slotWaiters;
+            return acquired;
+        }
+
+        /**
+         * 从新任务的目标队列开始，淘汰一个按 worse 排序最差且比新任务差的排队任务，名额转给新任务
+         */
+        template <typename WORSE>
+        bool dropFor(CONST ThreadTask& task, WORSE worse)
+        {
+            size_t active = _active.load(std::memory_order_relaxed);
+            size_t start = task.sequence % active;
+            for (size_t k = 0; k < active; k++)
+            {
+                size_t i = (start + k) % active;
+                auto victim = _aging ? _agingTasks[i].pollMaxAbove(task, worse) : _tasks[i].pollMaxAbove(task, worse);
+                if (!victim.has_value())
+                {
+                    continue;
+                }
+                _stats[i].dequeued.fetch_add(1, std::memory_order_relaxed);
+                _stats[i].rejected.fetch_add(1, std::memory_order_relaxed);
+                if (_config.exceptionHandler != nullptr)
+                {
+                    std::runtime_error runtime_error("ThreadPool task dropped");
+                    error_info er{threads::EXCEPTION_TASK_DROPPED, &runtime_error, i};
+                    _config.exceptionHandler(&er, &_config, &victim.value(), _pool);
+                }
+                return true;
+            }
+            return false;
+        }
+
+        int reject(ThreadTask& task)
+        {
+            _stats[task.sequence % _active].rejected.fetch_add(1, std::memory_order_relaxed);
+            if (_config.exceptionHandler != nullptr)
             {
+                std::runtime_error runtime_error("ThreadPool is full");
+                error_info er{threads::EXCEPTION_TASK_COUNT_FULL, &runtime_error};
+                _config.exceptionHandler(&er, &_config, &task, _pool);
+            }
+            return EXCEPTION_TASK_COUNT_FULL;
+        }
+
+        /**
+         * 在提交线程中执行任务，异常交给异常处理器，线程索引为线程数上限
+         */
+        void runInCaller(ThreadTask& task)
+        {
+            if (task.token.isCancelled())
+            {
+                return;
+            }
+            try
+            {
+                task.status = ThreadTask::RUNNING;
+                task.task();
+                task.status = ThreadTask::FINISHED;
+            }
+            catch (std::exception& ex)
+            {
+                error_info e{threads::EXCEPTION_TASK_ERROR, &ex, _capacity};
                 if (_config.exceptionHandler != nullptr)
                 {
-                    std::runtime_error runtime_error("ThreadPool is full");
-                    error_info er{threads::EXCEPTION_TASK_COUNT_FULL, &runtime_error};
-                    ThreadTask t = task;
-                    _config.exceptionHandler(&er, &_config, &t, _pool);
-                    return;
+                    _config.exceptionHandler(&e, &_config, &task, _pool);
                 }
             }
-            size_t index = (tc % _config.threadCount);
-            createEnv(index, index);
-            _tasks[index].push(task);
         }
 
         void createEnv(CONST size_t& beg, CONST size_t& end)
@@ -87,6 +687,7 @@ namespace tbs::threads
             {
                 if (!_threads.contains(index))
                 {
+                    ++_alive;
                     _threads[index] = createNewThread(index);
                     LOG_INFO("create new thread  {}", index);
                     _threads[index].detach();
@@ -111,63 +712,147 @@ namespace tbs::threads
             return std::thread(
                 [this, i]()
                 {
-                    while (_config.running)
+                    currentPool = this;
+                    work(i);
+                    // 对本对象的最后一次访问，此后 stop 可以返回、线程池可以析构
+                    --_alive;
+                });
+        }
+
+        void work(CONST size_t& i)
+        {
+            if (!_workerCpus[i].empty() && !CpuTopology::pinCurrentThread(_workerCpus[i]))
+            {
+                LOG_WARN("failed to pin thread {} to its cpus", i);
+            }
+            WorkerStats& stats = _stats[i];
+            auto idleSince = std::chrono::steady_clock::now();
+            while (_running)
+            {
+                event_info ei{event_info::WAITTING, nullptr, i, _active, _taskCount};
+                eventTrigger(ei);
+                auto taskOp = steal(i);
+                if (!taskOp.has_value())
+                {
+                    auto idle = std::chrono::duration_cast<time_utils::ms>(std::chrono::steady_clock::now() - idleSince);
+                    // 常驻槽位不退出，至少等待 1 毫秒，避免 maxIdleTime 为 0 时空转
+                    auto least = time_utils::ms(i < _minThreads ? 1 : 0);
+                    taskOp = dequeue(i, std::max(time_utils::ms(config().maxIdleTime) - idle, least));
+                }
+                if (!taskOp.has_value())
+                {
+                    // 队列中的任务可能被其他线程窃取，空闲满 maxIdleTime 才退出
+                    if (std::chrono::steady_clock::now() - idleSince < time_utils::ms(config().maxIdleTime))
                     {
-                        event_info ei{event_info::WAITTING, nullptr, i, _config.threadCount, _taskCount};
+                        continue;
+                    }
+                    if (i < _minThreads)
+                    {
+                        // 槽位 [0, minThreads) 的线程常驻，只有更高的槽位在空闲时退出
+                        idleSince = std::chrono::steady_clock::now();
+                        continue;
+                    }
+                    lockIt g(locker);
+                    if (queueEmpty(i))
+                    {
+                        _threads.erase(i);
+                        shrink();
+                        return;
+                    }
+                    continue;
+                }
+                ThreadTask t = taskOp.value();
+                if (t.status == ThreadTask::CREATED && t.token.isCancelled())
+                {
+                    // 惰性移除：已取消的任务留在队列里，出队时丢弃
+                    t.status = ThreadTask::CANCELED;
+                    releaseSlot();
+                }
+                ei.runningTask = &t;
+                ei.signal = event_info::PICKED;
+                eventTrigger(ei);
+                uint64_t runStart = time_utils::CycleClock::now();
+                if (t.status == ThreadTask::CREATED)
+                {
+                    uint64_t wait = elapsedNanos(t.enqueuedAt, runStart);
+                    stats.queueWait.record(wait);
+                    if (_config.targetQueueWait != 0 && wait > _config.targetQueueWait * 1000000)
+                    {
+                        grow();
+                    }
+                }
+                try
+                {
+                    if (t.status == ThreadTask::CREATED)
+                    {
+                        t.status = ThreadTask::RUNNING;
+                        ei.signal = event_info::RUNNING;
                         eventTrigger(ei);
-                        auto taskOp = _tasks[i].poll(time_utils::ms(config().maxIdleTime));
-                        if (!taskOp.has_value())
-                        {
-                            break;
-                        }
-                        ThreadTask t = taskOp.value();
-                        ei.runningTask = &t;
-                        ei.signal = event_info::PICKED;
+                        runStart = time_utils::CycleClock::now();
+                        stats.busySince.store(runStart, std::memory_order_relaxed);
+                        t.task();
+                        stats.runTime.record(elapsedNanos(runStart, time_utils::CycleClock::now()));
+                        t.status = ThreadTask::FINISHED;
+                        ei.signal = event_info::FINISHED;
                         eventTrigger(ei);
-                        try
-                        {
-                            if (t.status == ThreadTask::CREATED)
-                            {
-                                t.status = ThreadTask::RUNNING;
-                                ei.signal = event_info::RUNNING;
-                                eventTrigger(ei);
-                                t.task();
-                                t.status = ThreadTask::FINISHED;
-                                ei.signal = event_info::FINISHED;
-                                eventTrigger(ei);
-                            }
-                            else if (t.status == ThreadTask::CANCELED)
-                            {
-                                ei.signal = event_info::CANCELED;
-                                eventTrigger(ei);
-                                continue;
-                            }
-                        }
-                        catch (std::exception& ex)
-                        {
-                            error_info e{threads::EXCEPTION_TASK_ERROR, &ex, i};
-                            if (_config.exceptionHandler != nullptr)
-                            {
-                                _config.exceptionHandler(&e, &_config, &t, _pool);
-                            }
-                        }
-                        --_taskCount;
-                        {
-                            lockIt g(locker);
-                            _threads.erase(i);
-                        }
                     }
-                });
+                    else if (t.status == ThreadTask::CANCELED)
+                    {
+                        ei.signal = event_info::CANCELED;
+                        eventTrigger(ei);
+                        idleSince = std::chrono::steady_clock::now();
+                        continue;
+                    }
+                }
+                catch (std::exception& ex)
+                {
+                    if (t.status == ThreadTask::RUNNING)
+                    {
+                        stats.runTime.record(elapsedNanos(runStart, time_utils::CycleClock::now()));
+                    }
+                    error_info e{threads::EXCEPTION_TASK_ERROR, &ex, i};
+                    if (_config.exceptionHandler != nullptr)
+                    {
+                        _config.exceptionHandler(&e, &_config, &t, _pool);
+                    }
+                }
+                stats.busySince.store(0, std::memory_order_relaxed);
+                bump(stats.completed);
+                releaseSlot();
+                idleSince = std::chrono::steady_clock::now();
+            }
+            lockIt g(locker);
+            _threads.erase(i);
         }
 
         void threadStart()
         {
-            if (_config.running)
+            if (_running)
             {
                 throw std::runtime_error("ThreadPool has running");
             }
+            _maxThreads = std::max<size_t>(_config.maxThreads == 0 ? _config.threadCount : _config.maxThreads, 1);
+            _minThreads = std::clamp<size_t>(_config.minThreads == 0 ? _config.threadCount : _config.minThreads, 1, _maxThreads);
+            reserveWorkers(_maxThreads);
+            _active = std::clamp<size_t>(_config.threadCount, _minThreads, _maxThreads);
+            applyScheduling();
+            planPlacement();
+            _running = true;
             _config.running = true;
-            createEnv(0, _config.threadCount);
+            createEnv(0, _active);
+            if (_config.targetQueueWait != 0 && _maxThreads > _minThreads)
+            {
+                std::lock_guard<std::mutex> g(_monitorMutex);
+                _monitor = std::thread([this]() { monitor(); });
+            }
+            // 上次运行遗留在已收回槽位中的任务
+            for (size_t i = _active; i < _capacity; i++)
+            {
+                if (!queueEmpty(i))
+                {
+                    createEnv(i, i + 1);
+                }
+            }
         }
     };
 } // namespace tbs::threads
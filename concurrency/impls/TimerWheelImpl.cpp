@@ -0,0 +1,384 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#include <tbs/threads/TimerWheel.h>
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tbs::threads
+{
+    class TimerWheelImpl
+    {
+    private:
+        constexpr static uint32_t NIL = UINT32_MAX; // 空链表
+        constexpr static int ROOT_BITS = 8; // 第一层槽位数的位数
+        constexpr static int LEVEL_BITS = 6; // 其余各层槽位数的位数
+        constexpr static uint64_t ROOT_SIZE = 1ull << ROOT_BITS;
+        constexpr static uint64_t LEVEL_SIZE = 1ull << LEVEL_BITS;
+        constexpr static uint64_t ROOT_MASK = ROOT_SIZE - 1;
+        constexpr static uint64_t LEVEL_MASK = LEVEL_SIZE - 1;
+        constexpr static int LEVELS = 4; // 第一层之上的层数
+        constexpr static uint64_t MAX_SPAN = (1ull << (ROOT_BITS + LEVELS * LEVEL_BITS)) - 1; // 可表示的最远刻度
+
+        /**
+         * 定时任务节点，按下标串成槽位内的单向链表
+         */
+        struct Node
+        {
+            std::function<void()> task;
+            CancellationToken token;
+            uint64_t expires = 0; // 到期刻度
+            uint64_t period = 0; // 周期（刻度），0 为一次性任务
+            int priority = 0;
+            uint32_t next = NIL;
+        };
+
+        /**
+         * 已到期、等待提交到线程池的任务
+         */
+        struct Due
+        {
+            std::function<void()> task;
+            CancellationToken token;
+            int priority;
+            bool retry; // 线程池已满时是否在下一个刻度重试，周期任务直接跳过本次执行
+        };
+
+        ThreadPool& _pool;
+        CONST std::chrono::steady_clock::time_point _start = std::chrono::steady_clock::now();
+
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        bool _stopping = false;
+
+        std::deque<Node> _nodes; // 节点存储，扩容时已有节点不移动
+        std::vector<uint32_t> _free; // 空闲节点下标
+        std::array<uint32_t, ROOT_SIZE> _root; // 第一层槽位
+        std::array<std::array<uint32_t, LEVEL_SIZE>, LEVELS> _levels; // 其余各层槽位
+        uint64_t _next = 0; // 下一个待处理的刻度
+        uint64_t _wakeAt = UINT64_MAX; // 定时器线程计划醒来的刻度
+        size_t _count = 0; // 时间轮中的节点数
+
+        std::thread _worker;
+
+    public:
+        explicit TimerWheelImpl(ThreadPool& pool) : _pool(pool)
+        {
+            _root.fill(NIL);
+            for (auto& level : _levels)
+            {
+                level.fill(NIL);
+            }
+            _worker = std::thread([this]() { run(); });
+        }
+
+        ~TimerWheelImpl()
+        {
+            {
+                std::lock_guard<std::mutex> g(_mutex);
+                _stopping = true;
+            }
+            _cv.notify_one();
+            _worker.join();
+        }
+
+        uint64_t currentTick() CONST
+        {
+            return std::chrono::duration_cast<time_utils::ms>(std::chrono::steady_clock::now() - _start).count();
+        }
+
+        TimerHandle schedule(uint64_t delay, uint64_t period, std::function<void()>&& task, int priority)
+        {
+            CancellationSource source;
+            bool wake;
+            {
+                std::lock_guard<std::mutex> g(_mutex);
+                uint64_t now = currentTick();
+                if (_count == 0 && now > _next)
+                {
+                    // 时间轮为空时直接跳到当前刻度，避免定时器线程空转追赶
+                    _next = now;
+                }
+                uint32_t i = allocate();
+                Node& n = _nodes[i];
+                n.task = std::move(task);
+                n.token = source.token();
+                // 当前刻度已过去一部分，向上取整到下一个刻度，保证不会提前触发
+                n.expires = now + delay + 1;
+                n.period = period;
+                n.priority = priority;
+                insert(i);
+                _count++;
+                wake = n.expires < _wakeAt;
+            }
+            if (wake)
+            {
+                _cv.notify_one();
+            }
+            return TimerHandle(std::move(source));
+        }
+
+        size_t size() CONST
+        {
+            std::lock_guard<std::mutex> g(_mutex);
+            return _count;
+        }
+
+    private:
+        uint32_t allocate()
+        {
+            if (!_free.empty())
+            {
+                uint32_t i = _free.back();
+                _free.pop_back();
+                return i;
+            }
+            _nodes.emplace_back();
+            return static_cast<uint32_t>(_nodes.size() - 1);
+        }
+
+        void release(uint32_t i)
+        {
+            Node& n = _nodes[i];
+            n.task = nullptr;
+            n.token = CancellationToken();
+            _free.push_back(i);
+            _count--;
+        }
+
+        /**
+         * 按到期刻度与当前刻度的距离放入对应层的槽位
+         */
+        void insert(uint32_t i)
+        {
+            Node& n = _nodes[i];
+            uint32_t* slot;
+            if (n.expires < _next)
+            {
+                // 已过期，放入下一个待处理的槽位
+                slot = &_root[_next & ROOT_MASK];
+            }
+            else
+            {
+                uint64_t span = n.expires - _next;
+                if (span > MAX_SPAN)
+                {
+                    // 超出最高层的范围，先放在最远刻度，降级时重新计算
+                    span = MAX_SPAN;
+                }
+                uint64_t expires = _next + span;
+                if (span < ROOT_SIZE)
+                {
+                    slot = &_root[expires & ROOT_MASK];
+                }
+                else
+                {
+                    int level = 0;
+                    while (span >= (1ull << (ROOT_BITS + (level + 1) * LEVEL_BITS)))
+                    {
+                        level++;
+                    }
+                    slot = &_levels[level][(expires >> (ROOT_BITS + level * LEVEL_BITS)) & LEVEL_MASK];
+                }
+            }
+            n.next = *slot;
+            *slot = i;
+        }
+
+        /**
+         * 把高层的一个槽位降级到低层，顺便回收已取消的节点
+         * @return 该槽位的下标，为 0 时需要继续降级更高一层
+         */
+        uint64_t cascade(int level)
+        {
+            uint64_t index = (_next >> (ROOT_BITS + level * LEVEL_BITS)) & LEVEL_MASK;
+            uint32_t i = _levels[level][index];
+            _levels[level][index] = NIL;
+            while (i != NIL)
+            {
+                uint32_t next = _nodes[i].next;
+                if (_nodes[i].token.isCancelled())
+                {
+                    release(i);
+                }
+                else
+                {
+                    insert(i);
+                }
+                i = next;
+            }
+            return index;
+        }
+
+        /**
+         * 处理当前刻度：必要时降级高层槽位，取出第一层当前槽位中到期的节点
+         */
+        void tick(std::vector<Due>& due)
+        {
+            if ((_next & ROOT_MASK) == 0)
+            {
+                for (int level = 0; level < LEVELS && cascade(level) == 0; level++)
+                {
+                }
+            }
+            uint32_t i = _root[_next & ROOT_MASK];
+            _root[_next & ROOT_MASK] = NIL;
+            while (i != NIL)
+            {
+                Node& n = _nodes[i];
+                uint32_t next = n.next;
+                if (n.token.isCancelled())
+                {
+                    release(i);
+                }
+                else if (n.period == 0)
+                {
+                    due.push_back(Due{std::move(n.task), std::move(n.token), n.priority, true});
+                    release(i);
+                }
+                else
+                {
+                    due.push_back(Due{n.task, n.token, n.priority, false});
+                    n.expires = std::max(n.expires + n.period, _next + 1);
+                    insert(i);
+                }
+                i = next;
+            }
+            _next++;
+        }
+
+        /**
+         * 计算下一次需要醒来的刻度：第一层中下一个非空槽位，最迟到下一次降级
+         */
+        uint64_t nextWake() CONST
+        {
+            uint64_t boundary = (_next | ROOT_MASK) + 1;
+            for (uint64_t t = _next; t < boundary; t++)
+            {
+                if (_root[t & ROOT_MASK] != NIL)
+                {
+                    return t;
+                }
+            }
+            return boundary;
+        }
+
+        /**
+         * 把被线程池拒绝的一次性任务放回下一个刻度
+         */
+        void requeue(std::vector<Due>& retry)
+        {
+            for (auto& d : retry)
+            {
+                uint32_t i = allocate();
+                Node& n = _nodes[i];
+                n.task = std::move(d.task);
+                n.token = std::move(d.token);
+                n.expires = _next;
+                n.period = 0;
+                n.priority = d.priority;
+                insert(i);
+                _count++;
+            }
+            retry.clear();
+        }
+
+        void run()
+        {
+            std::vector<Due> due;
+            std::vector<Due> retry;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stopping)
+            {
+                if (_count == 0)
+                {
+                    _wakeAt = UINT64_MAX;
+                    _cv.wait(lock, [this]() { return _stopping || _count != 0; });
+                    continue;
+                }
+                uint64_t now = currentTick();
+                while (_next <= now)
+                {
+                    tick(due);
+                }
+                if (!due.empty())
+                {
+                    lock.unlock();
+                    for (auto& d : due)
+                    {
+                        // 不应用拒绝策略：定时器线程既不能阻塞等待名额，也不能替线程池执行任务
+                        if (!d.retry)
+                        {
+                            _pool.trySubmit(std::move(d.task), std::move(d.token), d.priority);
+                        }
+                        else if (_pool.trySubmit(d.task, d.token, d.priority) == EXCEPTION_TASK_COUNT_FULL)
+                        {
+                            retry.push_back(std::move(d));
+                        }
+                        // 线程池未运行时丢弃到期的任务
+                    }
+                    due.clear();
+                    lock.lock();
+                    requeue(retry);
+                    continue;
+                }
+                _wakeAt = nextWake();
+                _cv.wait_until(lock, _start + time_utils::ms(_wakeAt));
+            }
+        }
+    };
+
+} // namespace tbs::threads
+
+template <>
+void default_resetor<tbs::threads::TimerWheelImpl>(tbs::threads::TimerWheelImpl*& ptr)
+{
+    delete ptr;
+    ptr = nullptr;
+}
+
+namespace tbs::threads
+{
+    TimerWheel::TimerWheel(ThreadPool& pool) : PointerImpl(pool)
+    {
+    }
+
+    TimerWheel::~TimerWheel() = default;
+
+    TimerHandle TimerWheel::scheduleAfter(time_utils::ms delay, std::function<void()> task, int priority)
+    {
+        return getImpl().schedule(std::max<int64_t>(delay.count(), 0), 0, std::move(task), priority);
+    }
+
+    TimerHandle TimerWheel::scheduleAt(steady_time_point when, std::function<void()> task, int priority)
+    {
+        auto delay = std::chrono::ceil<time_utils::ms>(when - std::chrono::steady_clock::now());
+        return scheduleAfter(delay, std::move(task), priority);
+    }
+
+    TimerHandle TimerWheel::scheduleAt(system_time_point when, std::function<void()> task, int priority)
+    {
+        auto delay = std::chrono::ceil<time_utils::ms>(when - std::chrono::system_clock::now());
+        return scheduleAfter(delay, std::move(task), priority);
+    }
+
+    TimerHandle TimerWheel::scheduleEvery(time_utils::ms period, std::function<void()> task, time_utils::ms initialDelay, int priority)
+    {
+        if (period.count() < 1)
+        {
+            throw std::invalid_argument("TimerWheel: period must be at least 1 ms");
+        }
+        return getImpl().schedule(std::max<int64_t>(initialDelay.count(), 0), period.count(), std::move(task), priority);
+    }
+
+    size_t TimerWheel::size() const
+    {
+        return getImpl().size();
+    }
+} // namespace tbs::threads
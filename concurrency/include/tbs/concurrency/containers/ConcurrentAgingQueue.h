@@ -0,0 +1,307 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef CONCURRENTAGINGQUEUE_H
+#define CONCURRENTAGINGQUEUE_H
+
+#include <tbs/concurrency/adapters.h>
+#include <tbs/concurrency/containers/ConcurrentContainer.h>
+#include <tbs/concurrency/sync_point/SyncPoint.h>
+#include <tbs/time_utils.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <deque>
+#include <optional>
+
+namespace tbs::concurrency::containers
+{
+    /**
+     * @brief 分桶老化队列的存储：每个优先级一个 FIFO 桶，加上非空桶的位图。
+     *
+     * @tparam T 元素类型。
+     * @tparam LEVELS 优先级级数。
+     */
+    template <typename T, size_t LEVELS>
+    struct AgingBuckets
+    {
+        static_assert(LEVELS > 0 && LEVELS <= 64, "AgingBuckets: LEVELS must be in [1, 64]");
+
+        /**
+         * @brief 桶中的元素及其入队时刻（纳秒）。
+         */
+        struct Entry
+        {
+            uint64_t enqueued;
+            T value;
+        };
+
+        std::array<std::deque<Entry>, LEVELS> buckets; // 各优先级的 FIFO 桶
+        uint64_t nonEmpty = 0; // 第 i 位表示第 i 个桶非空
+        size_t size = 0; // 元素总数
+    };
+
+    /**
+     * @brief 线程安全的分桶老化优先队列。
+     *
+     * 优先级被截断到 [0, LEVELS) 共 LEVELS 级，级数越小越先出队，每级一个 FIFO 桶。
+     * 元素在队列中每等待 agingInterval，有效优先级提升一级：出队时只比较各非空桶的队首（桶内先入队的等待最久），
+     * 取 入队时刻 + 级数 × agingInterval 最小者，因此老化是 O(LEVELS) 的常数开销，不需要重建堆。
+     * agingInterval 为 0 时退化为严格按级出队、同级 FIFO。
+     *
+     * @tparam T 存储在队列中的元素类型。
+     * @tparam LEVELS 优先级级数，不超过 64。
+     * @tparam LOCK 用于同步的锁类型，默认为 `::SharedMutexLockAdapter`。
+     */
+    template <typename T, size_t LEVELS = 64, typename LOCK = ::SharedMutexLockAdapter>
+    class ConcurrentAgingQueue : public virtual concurrency::containers::ConcurrentContainer<AgingBuckets<T, LEVELS>, LOCK>
+    {
+    private:
+        mutable sync_point::SyncPoint m_syncPoint; // 用于同步的 SyncPoint 对象
+        uint64_t m_agingInterval = 0; // 提升一级所需的等待时间（纳秒）
+        using Base = ConcurrentContainer<AgingBuckets<T, LEVELS>, LOCK>; // 基类别名
+        using buckets_type = AgingBuckets<T, LEVELS>;
+
+        /**
+         * @brief 选出下一个出队的桶，队列必须非空。
+         */
+        size_t pick(CONST buckets_type& b) CONST
+        {
+            uint64_t mask = b.nonEmpty;
+            size_t best = std::countr_zero(mask);
+            if (m_agingInterval == 0)
+            {
+                return best;
+            }
+            uint64_t bestDeadline = b.buckets[best].front().enqueued + best * m_agingInterval;
+            mask &= mask - 1;
+            while (mask != 0)
+            {
+                size_t level = std::countr_zero(mask);
+                mask &= mask - 1;
+                uint64_t deadline = b.buckets[level].front().enqueued + level * m_agingInterval;
+                if (deadline < bestDeadline)
+                {
+                    best = level;
+                    bestDeadline = deadline;
+                }
+            }
+            return best;
+        }
+
+        static T take(buckets_type& b, size_t level)
+        {
+            auto& bucket = b.buckets[level];
+            T ret = std::move(bucket.front().value);
+            bucket.pop_front();
+            if (bucket.empty())
+            {
+                b.nonEmpty &= ~(1ull << level);
+            }
+            b.size--;
+            return ret;
+        }
+
+    public:
+        /**
+         * @brief 默认构造函数，不老化。
+         */
+        ConcurrentAgingQueue() = default;
+
+        /**
+         * @brief 使用给定的老化间隔构造。
+         *
+         * @param agingInterval 元素每等待该时长，有效优先级提升一级。
+         */
+        explicit ConcurrentAgingQueue(CONST time_utils::ms& agingInterval) :
+            m_agingInterval(std::chrono::duration_cast<std::chrono::nanoseconds>(agingInterval).count())
+        {
+        }
+
+        /**
+         * @brief 设置老化间隔，对已在队列中的元素同样生效。
+         *
+         * @param agingInterval 元素每等待该时长，有效优先级提升一级，为 0 时不老化。
+         */
+        void setAgingInterval(CONST time_utils::ms& agingInterval)
+        {
+            Base::writeAsAtomic([&](auto&) { m_agingInterval = std::chrono::duration_cast<std::chrono::nanoseconds>(agingInterval).count(); });
+        }
+
+        /**
+         * @brief 把优先级截断为桶的级数。
+         *
+         * @param priority 优先级。
+         * @return [0, LEVELS) 内的级数。
+         */
+        constexpr static size_t levelOf(int priority)
+        {
+            return static_cast<size_t>(std::clamp(priority, 0, static_cast<int>(LEVELS) - 1));
+        }
+
+        /**
+         * @brief 向队列中添加一个元素。
+         *
+         * @param val 要添加的元素。
+         * @param priority 元素的优先级，越小越先出队，截断到 [0, LEVELS)。
+         */
+        void push(const T& val, int priority)
+        {
+            uint64_t now = time_utils::CycleClock::nowNanos();
+            size_t level = levelOf(priority);
+            Base::writeAsAtomic(
+                [&](auto& b)
+                {
+                    b.buckets[level].push_back({now, val});
+                    b.nonEmpty |= 1ull << level;
+                    b.size++;
+                    m_syncPoint.accumulateFlag(1); // 更新同步标志
+                });
+        }
+
+        /**
+         * @brief 从队列中获取并移除有效优先级最高的元素，等待指定时间。
+         *
+         * @param timeout 等待超时时间。
+         * @return 获取到的元素，如果超时则返回空。
+         */
+        std::optional<T> poll(CONST time_utils::ms& timeout)
+        {
+            std::optional<T> ret;
+            m_syncPoint.wait_flag(1,
+                                  timeout,
+                                  [&](CONST sync_point::SyncPoint&, bool, bool, bool c, CONST int&)
+                                  {
+                                      if (c) // 旗帜被设置，说明有元素被添加或移除，唤醒等待线程
+                                      {
+                                          Base::writeAsAtomic(
+                                              [&](auto& q)
+                                              {
+                                                  if (q.size != 0)
+                                                  {
+                                                      ret = take(q, pick(q));
+                                                  }
+                                              });
+                                      }
+                                  });
+            if (ret.has_value())
+            {
+                m_syncPoint.accumulateFlag(-1); // 更新同步标志
+            }
+            return ret;
+        }
+
+        /**
+         * @brief 不等待地获取并移除有效优先级最高的元素，不占用 SyncPoint 的等待名额。
+         *
+         * @return 获取到的元素，队列为空时返回空。
+         */
+        std::optional<T> tryPoll()
+        {
+            std::optional<T> ret;
+            Base::writeAsAtomic(
+                [&](auto& q)
+                {
+                    if (q.size != 0)
+                    {
+                        ret = take(q, pick(q));
+                        m_syncPoint.accumulateFlag(-1); // 更新同步标志
+                    }
+                });
+            return ret;
+        }
+
+        /**
+         * @brief 移除并返回按 less 排序最大的元素，仅当它大于 bound 时才移除。
+         *
+         * 需要遍历全部元素，复杂度 O(n)，用于淘汰最旧或最低优先级元素等低频场景。
+         *
+         * @tparam LESS 比较函数类型。
+         * @param bound 被移除的元素必须大于该值。
+         * @param less 比较函数，less(a, b) 为 true 表示 a 小于 b。
+         * @return 被移除的元素，队列为空或最大元素不大于 bound 时返回空。
+         */
+        template <typename LESS>
+        std::optional<T> pollMaxAbove(CONST T& bound, LESS less)
+        {
+            std::optional<T> ret;
+            Base::writeAsAtomic(
+                [&](auto& b)
+                {
+                    std::deque<typename buckets_type::Entry>* bucket = nullptr;
+                    typename std::deque<typename buckets_type::Entry>::iterator worst;
+                    size_t worstLevel = 0;
+                    for (size_t level = 0; level < LEVELS; level++)
+                    {
+                        auto& candidate = b.buckets[level];
+                        for (auto it = candidate.begin(); it != candidate.end(); ++it)
+                        {
+                            if (bucket == nullptr || less(worst->value, it->value))
+                            {
+                                bucket = &candidate;
+                                worst = it;
+                                worstLevel = level;
+                            }
+                        }
+                    }
+                    if (bucket == nullptr || !less(bound, worst->value))
+                    {
+                        return;
+                    }
+                    ret = std::move(worst->value);
+                    bucket->erase(worst);
+                    if (bucket->empty())
+                    {
+                        b.nonEmpty &= ~(1ull << worstLevel);
+                    }
+                    b.size--;
+                    m_syncPoint.accumulateFlag(-1); // 更新同步标志
+                });
+            return ret;
+        }
+
+        /**
+         * @brief 判断队列是否为空。
+         *
+         * @return 如果队列为空则返回 true，否则返回 false。
+         */
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /**
+         * @brief 获取队列的大小。
+         *
+         * @return 队列中元素的数量。
+         */
+        size_t size() const
+        {
+            size_t r = 0;
+            Base::readAsAtomic([&r](auto& b) { r = b.size; });
+            return r;
+        }
+
+        /**
+         * @brief 清空队列。
+         */
+        void clear()
+        {
+            Base::writeAsAtomic(
+                [&](auto& b)
+                {
+                    for (auto& bucket : b.buckets)
+                    {
+                        bucket.clear();
+                    }
+                    b.nonEmpty = 0;
+                    b.size = 0;
+                    m_syncPoint.reset(); // 重置同步标志
+                });
+        }
+    };
+
+}; // namespace tbs::concurrency::containers
+
+#endif // CONCURRENTAGINGQUEUE_H
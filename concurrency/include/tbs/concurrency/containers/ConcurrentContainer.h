@@ -54,12 +54,13 @@ class ConcurrentContainer
             {
                 using _shared_lock_guard = guard::auto_shared_lock_op_guard<LOCK_ADAPTER>;
                 _shared_lock_guard g(m_lock);
+                f(m_container);
             }
             else
             {
                 _lock_guard g(m_lock);
+                f(m_container);
             }
-            f(m_container);
         }
 
         /**
@@ -81,9 +82,8 @@ class ConcurrentContainer
         /**
          * @brief 移动构造函数
          */
-        ConcurrentContainer(ConcurrentContainer &&o) noexcept
+        ConcurrentContainer(ConcurrentContainer &&o) noexcept : m_container(std::move(o.m_container))
         {
-            m_container = std::move(o.m_container);
         }
 
         /**
@@ -92,14 +92,14 @@ class ConcurrentContainer
         ConcurrentContainer &operator=(ConcurrentContainer &&o) noexcept
         {
             m_container = std::move(o.m_container);
+            return *this;
         }
 
         /**
          * @brief 拷贝构造函数
          */
-        ConcurrentContainer(CONST ConcurrentContainer &o)
+        ConcurrentContainer(CONST ConcurrentContainer &o) : m_container(o.m_container)
         {
-            m_container = o.m_container;
         }
 
         /**
@@ -108,6 +108,16 @@ class ConcurrentContainer
         ConcurrentContainer &operator=(CONST ConcurrentContainer &o)
         {
             m_container = o.m_container;
+            return *this;
+        }
+
+        /**
+         * @brief 以给定的底层容器构造，用于传入带有自定义分配器的容器
+         *
+         * @param container 底层容器
+         */
+        explicit ConcurrentContainer(CONTAINER &&container) : m_container(std::move(container))
+        {
         }
 
         /**
@@ -8,6 +8,7 @@
 #include <tbs/concurrency/adapters.h>
 #include <tbs/concurrency/containers/ConcurrentContainer.h>
 #include <tbs/concurrency/sync_point/SyncPoint.h>
+#include <algorithm>
 #include <optional>
 #include <queue>
 
@@ -30,7 +31,40 @@ namespace tbs::concurrency::containers
     private:
         mutable sync_point::SyncPoint m_syncPoint; // 用于同步的 SyncPoint 对象
         using Base = ConcurrentContainer<std::priority_queue<T, CONTAINER, COMPARE>, LOCK>; // 基类别名
+
+        /**
+         * @brief 访问 std::priority_queue 受保护的底层容器与比较器。
+         */
+        struct HeapAccess : std::priority_queue<T, CONTAINER, COMPARE>
+        {
+            static CONTAINER& container(std::priority_queue<T, CONTAINER, COMPARE>& q)
+            {
+                return q.*(&HeapAccess::c);
+            }
+
+            static COMPARE& compare(std::priority_queue<T, CONTAINER, COMPARE>& q)
+            {
+                return q.*(&HeapAccess::comp);
+            }
+        };
     public:
+        using queue_type = std::priority_queue<T, CONTAINER, COMPARE>;
+        using allocator_type = typename CONTAINER::allocator_type;
+
+        /**
+         * @brief 默认构造函数。
+         */
+        ConcurrentPriorityQueue() = default;
+
+        /**
+         * @brief 使用给定的分配器构造，底层容器的存储由该分配器分配。
+         *
+         * @param alloc 底层容器的分配器。
+         */
+        explicit ConcurrentPriorityQueue(const allocator_type& alloc) : Base(queue_type(COMPARE(), alloc))
+        {
+        }
+
         /**
          * @brief 向队列中添加一个元素。
          *
@@ -96,6 +130,28 @@ namespace tbs::concurrency::containers
             return ret;
         }
 
+        /**
+         * @brief 不等待地获取并移除队列顶部的元素。
+         *
+         * 不占用 SyncPoint 的等待名额，可以在其他线程阻塞于 poll 时调用，例如从其他线程的队列中窃取任务。
+         *
+         * @return 获取到的元素，队列为空时返回空。
+         */
+        std::optional<T> tryPoll()
+        {
+            std::optional<T> ret;
+            Base::writeAsAtomic(
+                [&](auto& q)
+                {
+                    if (!q.empty())
+                    {
+                        ret = q.top(); // 获取队列顶部元素
+                        q.pop(); // 移除队列顶部元素
+                        m_syncPoint.accumulateFlag(-1); // 更新同步标志
+                    }
+                });
+            return ret;
+        }
 
         /**
          * @brief 获取并移除队列顶部的元素。
@@ -154,6 +210,37 @@ namespace tbs::concurrency::containers
             return ret.value(); // 返回队列顶部元素
         }
 
+        /**
+         * @brief 移除并返回按 less 排序最大的元素，仅当它大于 bound 时才移除。
+         *
+         * 需要遍历全部元素并重建堆，复杂度 O(n)，用于淘汰最旧或最低优先级元素等低频场景。
+         *
+         * @tparam LESS 比较函数类型。
+         * @param bound 被移除的元素必须大于该值。
+         * @param less 比较函数，less(a, b) 为 true 表示 a 小于 b。
+         * @return 被移除的元素，队列为空或最大元素不大于 bound 时返回空。
+         */
+        template <typename LESS>
+        std::optional<T> pollMaxAbove(CONST T& bound, LESS less)
+        {
+            std::optional<T> ret;
+            Base::writeAsAtomic(
+                [&](auto& q)
+                {
+                    CONTAINER& c = HeapAccess::container(q);
+                    auto it = std::max_element(c.begin(), c.end(), less);
+                    if (it == c.end() || !less(bound, *it))
+                    {
+                        return;
+                    }
+                    ret = std::move(*it);
+                    c.erase(it);
+                    std::make_heap(c.begin(), c.end(), HeapAccess::compare(q));
+                    m_syncPoint.accumulateFlag(-1); // 更新同步标志
+                });
+            return ret;
+        }
+
         /**
          * @brief 判断队列是否为空。
          *
@@ -188,7 +275,10 @@ namespace tbs::concurrency::containers
             Base::writeAsAtomic(
                     [&](auto &q)
                     {
-                        q.clear();           // 清空队列
+                        while (!q.empty())   // priority_queue 没有 clear，逐个弹出以保留分配器
+                        {
+                            q.pop();
+                        }
                         m_syncPoint.reset(); // 重置同步标志
                     });
         }
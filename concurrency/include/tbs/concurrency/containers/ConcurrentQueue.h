@@ -20,14 +20,35 @@ namespace tbs::concurrency::containers
      *
      * @tparam T 队列中元素的类型
      * @tparam LockType 锁的类型，用于保护队列的并发访问
+     * @tparam ALLOC 底层 std::deque 的分配器类型，默认为 std::allocator
      */
-    template <typename T, typename LockType>
-    class ConcurrentQueue : public virtual ConcurrentContainer<std::queue<T>, LockType>
+    template <typename T, typename LockType, typename ALLOC = std::allocator<T>>
+    class ConcurrentQueue : public virtual ConcurrentContainer<std::queue<T, std::deque<T, ALLOC>>, LockType>
     {
+    public:
+        using queue_type = std::queue<T, std::deque<T, ALLOC>>;
+        using allocator_type = ALLOC;
+
     private:
+        using Base = ConcurrentContainer<queue_type, LockType>;
         mutable sync_point::SyncPoint m_sync_point{1};
 
-    public: /**
+    public:
+        /**
+         * 默认构造函数
+         */
+        ConcurrentQueue() = default;
+
+        /**
+         * 使用给定的分配器构造，队列元素的存储均由该分配器分配
+         *
+         * @param alloc 分配器
+         */
+        explicit ConcurrentQueue(const ALLOC& alloc) : Base(queue_type(alloc))
+        {
+        }
+
+        /**
              * 获取队列中元素的数量
              *
              * 此函数通过原子操作读取队列的大小，确保在多线程环境下的安全性
@@ -63,7 +84,11 @@ namespace tbs::concurrency::containers
             this->writeAsAtomic(
                 [&](auto& q)
                 {
-                    q.clear();
+                    // std::queue 没有 clear，逐个弹出以保留底层容器的分配器
+                    while (!q.empty())
+                    {
+                        q.pop();
+                    }
                     m_sync_point.reset();
                 });
         }
@@ -20,20 +20,39 @@ namespace tbs::concurrency::containers
      * @tparam K 映射的键类型。
      * @tparam V 映射的值类型。
      * @tparam LOCK 锁适配器类型，默认为 `SharedMutexLockAdapter`。
+     * @tparam ALLOC 底层映射的分配器类型，默认为 `std::allocator`，可替换为 ArenaAllocator 或 pmr 分配器。
      */
-    template <typename K, typename V, typename LOCK = SharedMutexLockAdapter>
-    class ConcurrentUnorderedMap : public virtual tbs::concurrency::containers::ConcurrentContainer<std::unordered_map<K, V>, LOCK>
+    template <typename K, typename V, typename LOCK = SharedMutexLockAdapter, typename ALLOC = std::allocator<std::pair<const K, V>>>
+    class ConcurrentUnorderedMap : public virtual tbs::concurrency::containers::ConcurrentContainer<std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, ALLOC>, LOCK>
     {
+    public:
+        using map_type = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, ALLOC>;
+        using allocator_type = ALLOC;
+
     private:
-        using Base = tbs::concurrency::containers::ConcurrentContainer<std::unordered_map<K, V>, LOCK>;
+        using Base = tbs::concurrency::containers::ConcurrentContainer<map_type, LOCK>;
 
     public:
+        /**
+         * @brief 默认构造函数。
+         */
+        ConcurrentUnorderedMap() = default;
+
+        /**
+         * @brief 使用给定的分配器构造，所有节点与桶数组均由该分配器分配。
+         *
+         * @param alloc 分配器。
+         */
+        explicit ConcurrentUnorderedMap(const ALLOC& alloc) : Base(map_type(alloc))
+        {
+        }
+
         /**
          * @brief 清空映射中的所有元素。
          */
         void clear()
         {
-            Base::writeAsAtomic([](std::unordered_map<K, V>& map) { map.clear(); });
+            Base::writeAsAtomic([](map_type& map) { map.clear(); });
         }
 
         /**
@@ -45,7 +64,7 @@ namespace tbs::concurrency::containers
         size_t erase(const K& key)
         {
             size_t r = 0;
-            Base::writeAsAtomic([&key, &r](std::unordered_map<K, V>& map) { r = map.erase(key); });
+            Base::writeAsAtomic([&key, &r](map_type& map) { r = map.erase(key); });
             return r;
         }
 
@@ -57,7 +76,7 @@ namespace tbs::concurrency::containers
         bool empty() const
         {
             bool r = false;
-            Base::readAsAtomic([&r](const std::unordered_map<K, V>& map) { r = map.empty(); });
+            Base::readAsAtomic([&r](const map_type& map) { r = map.empty(); });
             return r;
         }
 
@@ -69,7 +88,7 @@ namespace tbs::concurrency::containers
         size_t size() const
         {
             size_t r = 0;
-            Base::readAsAtomic([&r](const std::unordered_map<K, V>& map) { r = map.size(); });
+            Base::readAsAtomic([&r](const map_type& map) { r = map.size(); });
             return r;
         }
 
@@ -80,7 +99,7 @@ namespace tbs::concurrency::containers
          */
         void insert(const std::pair<K, V>& value)
         {
-            insert({value.first, value.second});
+            Base::writeAsAtomic([&value](map_type& map) { map.insert(value); });
         }
 
         /**
@@ -90,7 +109,7 @@ namespace tbs::concurrency::containers
          */
         void insert(std::pair<K, V>&& value)
         {
-            insert({std::move(value.first), std::move(value.second)});
+            Base::writeAsAtomic([&value](map_type& map) { map.insert(std::move(value)); });
         }
 
         /**
@@ -100,7 +119,7 @@ namespace tbs::concurrency::containers
          */
         void insert(std::initializer_list<std::pair<K, V>>&& values)
         {
-            Base::writeAsAtomic([&values](std::unordered_map<K, V>& map) { map.insert(values); });
+            Base::writeAsAtomic([&values](map_type& map) { map.insert(values); });
         }
 
         /**
@@ -112,7 +131,7 @@ namespace tbs::concurrency::containers
         bool contains(const K& key) const
         {
             bool r = false;
-            Base::readAsAtomic([&key, &r](const std::unordered_map<K, V>& map) { r = map.contains(key); });
+            Base::readAsAtomic([&key, &r](const map_type& map) { r = map.contains(key); });
             return r;
         }
 
@@ -136,7 +155,7 @@ namespace tbs::concurrency::containers
         V at(const K& key) CONST
         {
             V r;
-            Base::readAsAtomic([&key, &r](const std::unordered_map<K, V>& map) { r = map.at(key); });
+            Base::readAsAtomic([&key, &r](const map_type& map) { r = map.at(key); });
             return r;
         }
 
@@ -152,7 +171,7 @@ namespace tbs::concurrency::containers
                 return;
             }
             Base::readAsAtomic(
-                [f](const std::unordered_map<K, V>& map)
+                [f](const map_type& map)
                 {
                     for (auto& p : map)
                     {
@@ -176,7 +195,7 @@ namespace tbs::concurrency::containers
                 return;
             }
             Base::writeAsAtomic(
-                [f](std::unordered_map<K, V>& map)
+                [f](map_type& map)
                 {
                     for (auto& p : map)
                     {
@@ -196,7 +215,7 @@ namespace tbs::concurrency::containers
          */
         void operateIfExists(const K& key, std::function<void(V&)>&& operation)
         {
-            operateIfExists(key, [&operation](V& value, std::unordered_map<K, V>& map) { operation(value); }, nullptr);
+            operateIfExists(key, [&operation](V& value, map_type& map) { operation(value); }, nullptr);
         }
 
         /**
@@ -212,7 +231,7 @@ namespace tbs::concurrency::containers
                 return;
             }
             Base::readAsAtomic(
-                [&key, &operation](const std::unordered_map<K, V>& map)
+                [&key, &operation](const map_type& map)
                 {
                     if (map.contains(key))
                     {
@@ -228,7 +247,7 @@ namespace tbs::concurrency::containers
          * @param operation 要执行的操作，接受一个非常量引用参数和映射本身。
          * @param notFound 如果键不存在时要执行的操作，接受映射本身。
          */
-        void operateIfExists(const K& key, std::function<void(V&, std::unordered_map<K, V>& map)>&& operation, std::function<void(std::unordered_map<K, V>& map)>&& notFound)
+        void operateIfExists(const K& key, std::function<void(V&, map_type& map)>&& operation, std::function<void(map_type& map)>&& notFound)
         {
             if (operation == nullptr)
             {
@@ -236,7 +255,7 @@ namespace tbs::concurrency::containers
             }
 
             Base::writeAsAtomic(
-                [&key, &operation, &notFound](std::unordered_map<K, V> &map)
+                [&key, &operation, &notFound](map_type &map)
                 {
                     if (map.contains(key))
                     {
@@ -0,0 +1,48 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_CONCURRENCY_INCLUDE_TBS_CONCURRENCY_CONTAINERS_PMRCONTAINERS_H
+#define TBS_TOOL_LIB_CONCURRENCY_INCLUDE_TBS_CONCURRENCY_CONTAINERS_PMRCONTAINERS_H
+
+#include <memory_resource>
+#include <vector>
+#include <tbs/memory/Arena.h>
+#include <tbs/concurrency/containers/ConcurrentPriorityQueue.h>
+#include <tbs/concurrency/containers/ConcurrentQueue.h>
+#include <tbs/concurrency/containers/ConcurrentUnorderedMap.h>
+
+/**
+ * @brief 使用 std::pmr 多态分配器的并发容器别名。
+ *
+ * 这些容器可以在运行时绑定到任意 std::pmr::memory_resource（包括 tbs::memory::Arena），
+ * 例如：pmr::ConcurrentQueue<int, SharedMutexLockAdapter> q(&arena);
+ */
+namespace tbs::concurrency::containers::pmr
+{
+    template <typename K, typename V, typename LOCK = SharedMutexLockAdapter>
+    using ConcurrentUnorderedMap = containers::ConcurrentUnorderedMap<K, V, LOCK, std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+
+    template <typename T, typename LockType>
+    using ConcurrentQueue = containers::ConcurrentQueue<T, LockType, std::pmr::polymorphic_allocator<T>>;
+
+    template <typename T, typename COMPARE = std::greater_equal<T>, typename LOCK = ::SharedMutexLockAdapter>
+    using ConcurrentPriorityQueue = containers::ConcurrentPriorityQueue<T, std::pmr::vector<T>, COMPARE, LOCK>;
+} // namespace tbs::concurrency::containers::pmr
+
+/**
+ * @brief 使用 tbs::memory::ArenaAllocator 的并发容器别名，分配器在编译期确定，没有虚函数开销。
+ */
+namespace tbs::concurrency::containers::arena
+{
+    template <typename K, typename V, typename LOCK = SharedMutexLockAdapter>
+    using ConcurrentUnorderedMap = containers::ConcurrentUnorderedMap<K, V, LOCK, tbs::memory::ArenaAllocator<std::pair<const K, V>>>;
+
+    template <typename T, typename LockType>
+    using ConcurrentQueue = containers::ConcurrentQueue<T, LockType, tbs::memory::ArenaAllocator<T>>;
+
+    template <typename T, typename COMPARE = std::greater_equal<T>, typename LOCK = ::SharedMutexLockAdapter>
+    using ConcurrentPriorityQueue = containers::ConcurrentPriorityQueue<T, std::vector<T, tbs::memory::ArenaAllocator<T>>, COMPARE, LOCK>;
+} // namespace tbs::concurrency::containers::arena
+
+#endif // TBS_TOOL_LIB_CONCURRENCY_INCLUDE_TBS_CONCURRENCY_CONTAINERS_PMRCONTAINERS_H
@@ -44,12 +44,21 @@ namespace tbs::concurrency::sync_point
 
     class SyncPointImpl;
 
+}
+
+// SyncPointImpl 仅在源文件中完整可见，池化的重置函数在 SyncPointImpl.cpp 中显式实例化
+extern template void pooled_resetor<tbs::concurrency::sync_point::SyncPointImpl>(tbs::concurrency::sync_point::SyncPointImpl*&);
+
+namespace tbs::concurrency::sync_point
+{
 
     /**
      * SyncPoint 类用于线程同步，提供多种等待条件和标志的机制。
      *
+     * 实现对象从线程缓存对象池中分配，每个并发容器创建销毁时不再访问全局分配器。
+     * 实现对象构造后还要按等待数初始化，不能默认重建，被移动后再使用会抛出异常。
      */
-    class SyncPoint : protected virtual PointerImpl<SyncPointImpl>
+    class SyncPoint : protected virtual PointerImpl<SyncPointImpl, pooled_resetor<SyncPointImpl>, no_remake<SyncPointImpl>>
 
     {
     public:
@@ -165,7 +174,6 @@ namespace tbs::concurrency::sync_point
          */
         void wakeup();
         using PointerImpl::operator=;
-        using PointerImpl::PointerImpl;
 };
 
 };
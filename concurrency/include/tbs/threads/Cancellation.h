@@ -0,0 +1,94 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_THREADS_CANCELLATION_H
+#define TBS_THREADS_CANCELLATION_H
+#include <atomic>
+#include <memory>
+#include <tbs/defs.h>
+namespace tbs::threads
+{
+    class CancellationSource;
+
+    /**
+     * 取消令牌，只读地观察一个 CancellationSource 是否已取消
+     * @note 令牌可以随意拷贝，所有拷贝共享同一个标志；默认构造的令牌永远不会被取消
+     */
+    class CancellationToken
+    {
+    public:
+        CancellationToken() = default;
+
+        /**
+         * 获取是否已取消，一次 relaxed 原子读取，适合在运行中的任务里频繁轮询
+         * @return 是否已取消
+         */
+        bool isCancelled() CONST
+        {
+            return _flag != nullptr && _flag->load(std::memory_order_relaxed);
+        }
+
+        /**
+         * 获取令牌是否可能被取消
+         * @return 关联了 CancellationSource 时为 true
+         */
+        bool canBeCancelled() CONST
+        {
+            return _flag != nullptr;
+        }
+
+    private:
+        friend class CancellationSource;
+
+        explicit CancellationToken(std::shared_ptr<std::atomic_bool> flag) : _flag(std::move(flag))
+        {
+        }
+
+        std::shared_ptr<std::atomic_bool> _flag; // 取消标志
+    };
+
+    /**
+     * 取消源，发出取消请求
+     * 把 token() 交给 ThreadPool::submit 后，尚在队列中的任务出队时直接丢弃，运行中的任务通过轮询令牌自行结束。
+     * @note 取消源可以拷贝，所有拷贝共享同一个标志；取消不可撤销
+     */
+    class CancellationSource
+    {
+    public:
+        CancellationSource() : _flag(std::make_shared<std::atomic_bool>(false))
+        {
+        }
+
+        /**
+         * 请求取消
+         */
+        void cancel() CONST
+        {
+            _flag->store(true, std::memory_order_relaxed);
+        }
+
+        /**
+         * 获取是否已取消
+         * @return 是否已取消
+         */
+        bool isCancelled() CONST
+        {
+            return _flag->load(std::memory_order_relaxed);
+        }
+
+        /**
+         * 获取关联的取消令牌
+         * @return 取消令牌
+         */
+        CancellationToken token() CONST
+        {
+            return CancellationToken(_flag);
+        }
+
+    private:
+        std::shared_ptr<std::atomic_bool> _flag; // 取消标志
+    };
+} // namespace tbs::threads
+
+#endif // TBS_THREADS_CANCELLATION_H
@@ -0,0 +1,627 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_THREADS_COROUTINE_H
+#define TBS_THREADS_COROUTINE_H
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <tbs/defs.h>
+#include <tbs/threads/ThreadPool.h>
+namespace tbs::threads
+{
+    template <typename T = void>
+    class Task;
+
+    namespace detail
+    {
+        /**
+         * 协程结束时把执行权交还给等待者（对称转移），没有等待者时回到恢复者
+         */
+        struct FinalAwaiter
+        {
+            bool await_ready() CONST noexcept
+            {
+                return false;
+            }
+
+            template <typename PROMISE>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<PROMISE> h) CONST noexcept
+            {
+                return h.promise().continuation;
+            }
+
+            void await_resume() CONST noexcept
+            {
+            }
+        };
+
+        struct TaskPromiseBase
+        {
+            std::coroutine_handle<> continuation = std::noop_coroutine(); // 等待本任务的协程
+
+            std::suspend_always initial_suspend() CONST noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() CONST noexcept
+            {
+                return {};
+            }
+        };
+
+        template <typename T>
+        struct TaskPromise : TaskPromiseBase
+        {
+            std::variant<std::monostate, T, std::exception_ptr> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U&& v)
+            {
+                value.template emplace<1>(std::forward<U>(v));
+            }
+
+            void unhandled_exception() noexcept
+            {
+                value.template emplace<2>(std::current_exception());
+            }
+
+            T result()
+            {
+                if (value.index() == 2)
+                {
+                    std::rethrow_exception(std::get<2>(value));
+                }
+                return std::move(std::get<1>(value));
+            }
+        };
+
+        template <>
+        struct TaskPromise<void> : TaskPromiseBase
+        {
+            std::exception_ptr exception;
+
+            Task<void> get_return_object() noexcept;
+
+            void return_void() CONST noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception = std::current_exception();
+            }
+
+            void result() CONST
+            {
+                if (exception)
+                {
+                    std::rethrow_exception(exception);
+                }
+            }
+        };
+
+        /**
+         * 启动后自行销毁的协程，用于驱动组合子中的子任务
+         */
+        struct DetachedTask
+        {
+            struct promise_type
+            {
+                DetachedTask get_return_object() noexcept
+                {
+                    return DetachedTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() CONST noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() CONST noexcept
+                {
+                    return {};
+                }
+
+                void return_void() CONST noexcept
+                {
+                }
+
+                void unhandled_exception() CONST noexcept
+                {
+                    std::terminate();
+                }
+            };
+
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        /**
+         * 等待 awaitable 完成后执行 notifier；notifier 在 await_suspend 中销毁本协程并返回下一个要执行的协程
+         */
+        template <typename AWAITABLE, typename NOTIFIER>
+        DetachedTask notifyWhenReady(AWAITABLE awaitable, NOTIFIER notifier)
+        {
+            co_await awaitable;
+            co_await notifier;
+        }
+
+        /**
+         * whenAll 的计数器，初值为子任务数加一，多出的一次由发起者在启动全部子任务后扣除，
+         * 因此子任务在发起者的 await_suspend 中同步完成时不会提前恢复发起者
+         */
+        struct WhenAllLatch
+        {
+            std::atomic_size_t count;
+            std::coroutine_handle<> continuation;
+
+            explicit WhenAllLatch(size_t n) : count(n + 1)
+            {
+            }
+        };
+
+        struct WhenAllNotifier
+        {
+            WhenAllLatch* latch;
+
+            bool await_ready() CONST noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> self) CONST noexcept
+            {
+                WhenAllLatch* l = latch;
+                self.destroy();
+                return l->count.fetch_sub(1, std::memory_order_acq_rel) == 1 ? l->continuation : std::noop_coroutine();
+            }
+
+            void await_resume() CONST noexcept
+            {
+            }
+        };
+
+        /**
+         * 启动全部驱动协程并在最后一个完成时恢复等待者
+         */
+        struct WhenAllAwaiter
+        {
+            WhenAllLatch& latch;
+            std::vector<DetachedTask>& drivers;
+
+            bool await_ready() CONST noexcept
+            {
+                return drivers.empty();
+            }
+
+            bool await_suspend(std::coroutine_handle<> h) CONST noexcept
+            {
+                latch.continuation = h;
+                for (auto& d : drivers)
+                {
+                    d.handle.resume();
+                }
+                return latch.count.fetch_sub(1, std::memory_order_acq_rel) != 1;
+            }
+
+            void await_resume() CONST noexcept
+            {
+            }
+        };
+
+        template <typename T>
+        using NonVoid = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        /**
+         * 组合子访问 Task 内部的入口
+         */
+        struct TaskAccess
+        {
+            template <typename T>
+            static auto ready(Task<T>& task) noexcept
+            {
+                return task.ready();
+            }
+
+            template <typename T>
+            static NonVoid<T> result(Task<T>& task)
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    task.result();
+                    return {};
+                }
+                else
+                {
+                    return task.result();
+                }
+            }
+        };
+
+        /**
+         * whenAny 的共享状态，由各驱动协程共同持有，落选的子任务在 whenAny 返回后仍可以安全地运行完
+         */
+        template <typename T>
+        struct WhenAnyState
+        {
+            std::vector<Task<T>> tasks;
+            std::atomic_bool won{false}; // 是否已有子任务完成
+            std::atomic_bool handoff{false}; // 发起者与首个完成者中后到的一方负责恢复等待者
+            size_t index = 0; // 首个完成的子任务
+            std::coroutine_handle<> continuation;
+        };
+
+        template <typename T>
+        struct WhenAnyNotifier
+        {
+            std::shared_ptr<WhenAnyState<T>> state;
+            size_t index;
+
+            bool await_ready() CONST noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> self) noexcept
+            {
+                std::shared_ptr<WhenAnyState<T>> s = std::move(state);
+                size_t i = index;
+                self.destroy();
+                if (s->won.exchange(true, std::memory_order_acq_rel))
+                {
+                    return std::noop_coroutine();
+                }
+                s->index = i;
+                return s->handoff.exchange(true, std::memory_order_acq_rel) ? s->continuation : std::noop_coroutine();
+            }
+
+            void await_resume() CONST noexcept
+            {
+            }
+        };
+
+        template <typename T>
+        struct WhenAnyAwaiter
+        {
+            std::shared_ptr<WhenAnyState<T>>& state;
+            std::vector<DetachedTask>& drivers;
+
+            bool await_ready() CONST noexcept
+            {
+                return drivers.empty();
+            }
+
+            bool await_suspend(std::coroutine_handle<> h) CONST noexcept
+            {
+                state->continuation = h;
+                for (auto& d : drivers)
+                {
+                    d.handle.resume();
+                }
+                return !state->handoff.exchange(true, std::memory_order_acq_rel);
+            }
+
+            void await_resume() CONST noexcept
+            {
+            }
+        };
+
+        /**
+         * syncWait 完成时唤醒阻塞的线程
+         */
+        struct SyncWaitEvent
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool done = false;
+        };
+
+        struct SyncWaitNotifier
+        {
+            SyncWaitEvent* event;
+
+            bool await_ready() CONST noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> self) CONST noexcept
+            {
+                SyncWaitEvent* e = event;
+                self.destroy();
+                std::lock_guard<std::mutex> g(e->mutex);
+                e->done = true;
+                e->cv.notify_all();
+                return std::noop_coroutine();
+            }
+
+            void await_resume() CONST noexcept
+            {
+            }
+        };
+    } // namespace detail
+
+    /**
+     * 惰性启动的协程任务
+     * 创建时不执行，被 co_await 时才在等待者的线程上开始执行；完成时通过对称转移直接恢复等待者，
+     * 同步完成的协程链不会加深调用栈，除协程帧外每次恢复不再分配内存。
+     * @tparam T 结果类型
+     * @note 任务只能被等待一次，结果被移出；析构时销毁协程帧，不能析构已启动但未完成的任务
+     */
+    template <typename T>
+    class Task
+    {
+    public:
+        using promise_type = detail::TaskPromise<T>;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        Task() = default;
+
+        explicit Task(handle_type handle) : _handle(handle)
+        {
+        }
+
+        Task(Task&& o) noexcept : _handle(std::exchange(o._handle, nullptr))
+        {
+        }
+
+        Task& operator=(Task&& o) noexcept
+        {
+            if (this != &o)
+            {
+                reset();
+                _handle = std::exchange(o._handle, nullptr);
+            }
+            return *this;
+        }
+
+        DELETE_COPY_CONSTRUCTION(Task);
+        DELETE_COPY_ASSIGNMENT(Task);
+
+        ~Task()
+        {
+            reset();
+        }
+
+        /**
+         * 获取任务是否已执行完毕
+         * @return 是否已执行完毕，空任务返回 true
+         */
+        bool done() CONST noexcept
+        {
+            return !_handle || _handle.done();
+        }
+
+        /**
+         * 启动任务并等待其结果
+         * @return 等待体，恢复时返回结果或重新抛出任务中的异常
+         */
+        auto operator co_await() noexcept
+        {
+            struct Awaiter : ReadyAwaiter
+            {
+                T await_resume()
+                {
+                    return this->handle.promise().result();
+                }
+            };
+            return Awaiter{{_handle}};
+        }
+
+    private:
+        friend struct detail::TaskAccess;
+
+        /**
+         * 启动任务并在完成时恢复等待者，不取出结果
+         */
+        struct ReadyAwaiter
+        {
+            handle_type handle;
+
+            bool await_ready() CONST noexcept
+            {
+                return !handle || handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) CONST noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            void await_resume() CONST noexcept
+            {
+            }
+        };
+
+        ReadyAwaiter ready() CONST noexcept
+        {
+            return ReadyAwaiter{_handle};
+        }
+
+        T result()
+        {
+            return _handle.promise().result();
+        }
+
+        void reset()
+        {
+            if (_handle)
+            {
+                _handle.destroy();
+                _handle = nullptr;
+            }
+        }
+
+        handle_type _handle = nullptr;
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept
+        {
+            return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept
+        {
+            return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+        }
+    } // namespace detail
+
+    /**
+     * 在线程池工作线程上恢复协程的等待体，由 ThreadPool::schedule 创建
+     * 恢复任务是一个只捕获协程句柄的普通任务，放得进 std::function 的内联存储，不额外分配内存。
+     * @note 恢复任务被 REJECT_POLICY_DROP_* 淘汰时协程不会再被恢复；线程池停止时尚在队列中的协程等到重新启动后才恢复
+     */
+    class ScheduleAwaiter
+    {
+    public:
+        ScheduleAwaiter(ThreadPool& pool, int priority) : _pool(pool), _priority(priority)
+        {
+        }
+
+        bool await_ready() CONST noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            int code = _pool.submit([h]() { h.resume(); }, _priority);
+            if (code < 0)
+            {
+                // 任务没有入队，协程不会在别处恢复，可以安全地访问本对象
+                _code = code;
+                return false;
+            }
+            // 已入队或已在提交线程中恢复，此后协程可能已在运行甚至结束，不能再访问本对象
+            return true;
+        }
+
+        /**
+         * @throws std::runtime_error 线程池拒绝了恢复任务
+         */
+        void await_resume() CONST
+        {
+            if (_code < 0)
+            {
+                throw std::runtime_error("ThreadPool rejected the coroutine");
+            }
+        }
+
+    private:
+        ThreadPool& _pool;
+        int _priority;
+        int _code = SUBMIT_ACCEPTED;
+    };
+
+    /**
+     * 并发等待全部任务
+     * 任务在等待者的线程上依次启动，各自挂起（如 co_await pool.schedule()）后并发执行，最后完成的任务直接恢复等待者。
+     * @param tasks 任务
+     * @return 按 tasks 顺序排列的结果，void 任务对应 std::monostate；有任务抛出异常时，在全部任务结束后重新抛出第一个
+     */
+    template <typename T>
+    Task<std::vector<detail::NonVoid<T>>> whenAll(std::vector<Task<T>> tasks)
+    {
+        detail::WhenAllLatch latch(tasks.size());
+        std::vector<detail::DetachedTask> drivers;
+        drivers.reserve(tasks.size());
+        for (auto& t : tasks)
+        {
+            drivers.push_back(detail::notifyWhenReady(detail::TaskAccess::ready(t), detail::WhenAllNotifier{&latch}));
+        }
+        co_await detail::WhenAllAwaiter{latch, drivers};
+        std::vector<detail::NonVoid<T>> results;
+        results.reserve(tasks.size());
+        for (auto& t : tasks)
+        {
+            results.push_back(detail::TaskAccess::result(t));
+        }
+        co_return results;
+    }
+
+    /**
+     * 并发等待全部任务，结果类型可以不同
+     * @param tasks 任务
+     * @return 各任务的结果，void 任务对应 std::monostate；有任务抛出异常时，在全部任务结束后重新抛出第一个
+     */
+    template <typename... TS>
+    Task<std::tuple<detail::NonVoid<TS>...>> whenAll(Task<TS>... tasks)
+    {
+        detail::WhenAllLatch latch(sizeof...(TS));
+        std::vector<detail::DetachedTask> drivers{detail::notifyWhenReady(detail::TaskAccess::ready(tasks), detail::WhenAllNotifier{&latch})...};
+        co_await detail::WhenAllAwaiter{latch, drivers};
+        // 花括号初始化按从左到右的顺序求值
+        co_return std::tuple<detail::NonVoid<TS>...>{detail::TaskAccess::result(tasks)...};
+    }
+
+    /**
+     * 等待最先完成的任务
+     * 落选的任务不会被取消，仍在后台运行到结束，需要提前结束时配合 CancellationSource 使用；
+     * 它们的协程帧由共享状态持有，在全部任务结束后释放。
+     * @param tasks 任务，不能为空
+     * @return 最先完成的任务的下标及结果；它抛出异常时重新抛出
+     * @throws std::invalid_argument tasks 为空
+     */
+    template <typename T>
+    Task<std::pair<size_t, detail::NonVoid<T>>> whenAny(std::vector<Task<T>> tasks)
+    {
+        if (tasks.empty())
+        {
+            throw std::invalid_argument("whenAny requires at least one task");
+        }
+        auto state = std::make_shared<detail::WhenAnyState<T>>();
+        state->tasks = std::move(tasks);
+        std::vector<detail::DetachedTask> drivers;
+        drivers.reserve(state->tasks.size());
+        for (size_t i = 0; i < state->tasks.size(); i++)
+        {
+            drivers.push_back(detail::notifyWhenReady(detail::TaskAccess::ready(state->tasks[i]), detail::WhenAnyNotifier<T>{state, i}));
+        }
+        co_await detail::WhenAnyAwaiter<T>{state, drivers};
+        co_return std::pair<size_t, detail::NonVoid<T>>{state->index, detail::TaskAccess::result(state->tasks[state->index])};
+    }
+
+    /**
+     * 在当前线程上启动任务并阻塞到它完成，用于从普通函数进入协程
+     * @param task 任务
+     * @return 任务的结果；任务抛出异常时重新抛出
+     * @note 不能在任务所依赖的线程池的工作线程上调用，否则可能因占用工作线程而死锁
+     */
+    template <typename T>
+    T syncWait(Task<T> task)
+    {
+        detail::SyncWaitEvent event;
+        detail::notifyWhenReady(detail::TaskAccess::ready(task), detail::SyncWaitNotifier{&event}).handle.resume();
+        {
+            std::unique_lock<std::mutex> l(event.mutex);
+            event.cv.wait(l, [&]() { return event.done; });
+        }
+        if constexpr (std::is_void_v<T>)
+        {
+            detail::TaskAccess::result(task);
+        }
+        else
+        {
+            return detail::TaskAccess::result(task);
+        }
+    }
+} // namespace tbs::threads
+
+#endif // TBS_THREADS_COROUTINE_H
@@ -0,0 +1,69 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_THREADS_CPUTOPOLOGY_H
+#define TBS_THREADS_CPUTOPOLOGY_H
+#include <string_view>
+#include <vector>
+#include <tbs/defs.h>
+namespace tbs::threads
+{
+    /**
+     * NUMA 节点及其 CPU
+     */
+    struct NumaNode
+    {
+        int id; // 节点编号，与 /sys/devices/system/node/node<id> 一致
+        std::vector<int> cpus; // 节点内当前进程可用的 CPU，升序
+    };
+
+    /**
+     * CPU / NUMA 拓扑
+     * Linux 下解析 /sys/devices/system/node，并与进程的 CPU 亲和性取交集；无法获取拓扑时视为单个节点 0。
+     */
+    class CpuTopology
+    {
+    public:
+        /**
+         * 获取系统拓扑，首次调用时解析并缓存
+         * @return 系统拓扑
+         */
+        static CONST CpuTopology& system();
+
+        /**
+         * 解析 Linux cpulist 格式的 CPU 列表，如 "0-3,8,10-11"
+         * @param list CPU 列表
+         * @return 升序、去重的 CPU 编号
+         */
+        static std::vector<int> parseCpuList(std::string_view list);
+
+        /**
+         * 把当前线程绑定到给定的 CPU 集合（sched_setaffinity），非 Linux 平台上什么也不做
+         * @param cpus CPU 集合
+         * @return 是否绑定成功
+         */
+        static bool pinCurrentThread(CONST std::vector<int>& cpus);
+
+        /**
+         * 获取至少有一个可用 CPU 的节点，按节点编号升序
+         * @return 节点列表
+         */
+        CONST std::vector<NumaNode>& nodes() CONST
+        {
+            return _nodes;
+        }
+
+        /**
+         * 获取 CPU 所在的节点编号
+         * @param cpu CPU 编号
+         * @return 节点编号，未知的 CPU 返回 -1
+         */
+        int nodeOf(int cpu) CONST;
+
+    private:
+        std::vector<NumaNode> _nodes;
+    };
+} // namespace tbs::threads
+
+#endif // TBS_THREADS_CPUTOPOLOGY_H
@@ -0,0 +1,84 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_THREADS_TASKGRAPH_H
+#define TBS_THREADS_TASKGRAPH_H
+#include <functional>
+#include <tbs/PointerToImpl.h>
+#include <tbs/threads/ThreadPool.h>
+namespace tbs::threads
+{
+    class TaskGraphImpl;
+} // namespace tbs::threads
+
+/**
+ * 在实现文件中特化，保证释放 TaskGraphImpl 时它是完整类型，析构函数一定会执行
+ */
+template <>
+void default_resetor<tbs::threads::TaskGraphImpl>(tbs::threads::TaskGraphImpl*& ptr);
+
+namespace tbs::threads
+{
+    /**
+     * 有向无环任务图
+     * 节点是任务函数，边 from -> to 表示 to 依赖 from。每个节点带一个原子的前驱计数，前驱全部完成的瞬间由完成最后一个前驱的线程调度它：
+     * 其中一个直接在该线程上接着执行，其余提交到线程池，工作线程从不阻塞等待依赖。
+     * 图在首次运行时检查环并分配计数器，之后只要不再修改，重复运行只重置计数器，不分配内存。
+     * @note 任务图不支持拷贝与移动；线程池必须比任务图存活更久
+     * @note 节点任务被 REJECT_POLICY_DROP_* 淘汰时 run 不会返回；被拒绝时在当前线程上直接执行
+     */
+    class TaskGraph final : protected virtual PointerImpl<TaskGraphImpl>
+    {
+    public:
+        /**
+         * 构造函数
+         * @param pool 执行节点的线程池
+         */
+        explicit TaskGraph(ThreadPool& pool);
+
+        /**
+         * 析构函数
+         */
+        ~TaskGraph() override;
+
+        DELETE_COPY_ASSIGNMENT(TaskGraph); // 删除拷贝赋值操作
+        DELETE_COPY_CONSTRUCTION(TaskGraph); // 删除拷贝构造函数
+
+        /**
+         * 添加节点
+         * @param task 任务函数
+         * @param priority 提交到线程池时的优先级
+         * @return 节点编号，从 0 开始连续分配
+         * @throws std::logic_error 图正在运行
+         */
+        size_t addNode(std::function<void()> task, int priority = 0);
+
+        /**
+         * 添加依赖：to 在 from 完成后才执行
+         * @param from 前驱节点
+         * @param to 后继节点
+         * @throws std::invalid_argument 节点编号无效或 from 与 to 相同
+         * @throws std::logic_error 图正在运行
+         */
+        void addEdge(size_t from, size_t to);
+
+        /**
+         * 运行整张图并阻塞到全部节点结束
+         * 有节点抛出异常时，尚未开始的节点不再执行，全部结束后重新抛出第一个异常。
+         * @throws std::invalid_argument 图中有环
+         * @throws std::logic_error 图正在运行
+         * @throws std::runtime_error 线程池未运行
+         * @note 不能在同一线程池的工作线程上调用，否则可能因占用工作线程而死锁
+         */
+        void run();
+
+        /**
+         * 获取节点数
+         * @return 节点数
+         */
+        size_t size() const;
+    };
+} // namespace tbs::threads
+
+#endif // TBS_THREADS_TASKGRAPH_H
@@ -4,15 +4,47 @@
 
 #ifndef THREADPOOL_H
 #define THREADPOOL_H
+#include <cstdint>
 #include <functional>
+#include <vector>
 #include <tbs/PointerToImpl.h>
+#include <tbs/threads/Cancellation.h>
+#include <tbs/threads/ThreadPoolMetrics.h>
+namespace tbs::threads
+{
+    class ThreadPoolImpl;
+} // namespace tbs::threads
+
+/**
+ * 在实现文件中特化，保证释放 ThreadPoolImpl 时它是完整类型，析构函数一定会执行
+ */
+template <>
+void default_resetor<tbs::threads::ThreadPoolImpl>(tbs::threads::ThreadPoolImpl*& ptr);
+
 namespace tbs::threads
 {
 
     constexpr static int EXCEPTION_TASK_COUNT_FULL = -1; // 任务队列已满异常
     constexpr static int EXCEPTION_TASK_ERROR = -2; // 任务执行错误异常
+    constexpr static int EXCEPTION_TASK_DROPPED = -3; // 排队中的任务被淘汰
+    constexpr static int EXCEPTION_NOT_RUNNING = -4; // 线程池未运行
+
+    constexpr static int SUBMIT_ACCEPTED = 0; // 任务已入队
+    constexpr static int SUBMIT_CALLER_RAN = 1; // 队列已满，任务已在提交线程中执行
+
+    constexpr static int REJECT_POLICY_REJECT = 0; // 队列已满时拒绝新任务，返回 EXCEPTION_TASK_COUNT_FULL
+    constexpr static int REJECT_POLICY_BLOCK = 1; // 队列已满时阻塞等待空位，超时后拒绝
+    constexpr static int REJECT_POLICY_CALLER_RUNS = 2; // 队列已满时在提交线程中直接执行
+    constexpr static int REJECT_POLICY_DROP_OLDEST = 3; // 队列已满时淘汰最早提交的排队任务
+    constexpr static int REJECT_POLICY_DROP_LOWEST_PRIORITY = 4; // 队列已满时淘汰最后才会执行的排队任务，新任务不优于它时拒绝新任务
+
+    constexpr static int PLACEMENT_NONE = 0; // 工作线程不绑定 CPU
+    constexpr static int PLACEMENT_CPU_SET = 1; // 每个工作线程绑定到整个 cpuSet
+    constexpr static int PLACEMENT_SPREAD = 2; // 工作线程轮流分配到各 NUMA 节点，绑定到节点内的 CPU
+    constexpr static int PLACEMENT_PACK = 3; // 按节点顺序逐个占用 CPU，占满一个节点再用下一个，每个工作线程绑定一个 CPU
 
     class ThreadPool;
+    class ScheduleAwaiter;
     struct ThreadPoolData;
     struct error_info;
     struct ThreadTask;
@@ -60,13 +92,21 @@ namespace tbs::threads
     struct ThreadPoolData
     {
         const char* threadPoolName; // 线程池名称
-        size_t threadCount; // 线程池中的线程数
+        size_t threadCount; // 线程池中的线程数，开启弹性伸缩时为启动时的线程数
         size_t maxTaskCount; // 最大任务数
         bool running; // 线程池是否正在运行
         exception_handler exceptionHandler = nullptr; // 异常处理器
         thread_pool_event_handler eventHandler = nullptr; // 事件处理器
         size_t maxIdleThreadCount = threadCount; // 最大空闲线程数
         size_t maxIdleTime = 5000; // 空闲线程的最大空闲时间（毫秒）
+        int rejectPolicy = REJECT_POLICY_REJECT; // 未完成任务数达到 maxTaskCount * 当前线程数时的处理策略
+        size_t rejectTimeout = 1000; // REJECT_POLICY_BLOCK 的最长等待时间（毫秒）
+        size_t priorityAgingInterval = 0; // 优先级老化间隔（毫秒），非 0 时任务排队每满该时长优先级提升一级，优先级截断到 [0, 63]；启动时生效
+        int placement = PLACEMENT_NONE; // 工作线程的 CPU 放置策略，启动时生效
+        std::vector<int> cpuSet{}; // 工作线程可用的 CPU，为空时使用进程可用的全部 CPU
+        size_t minThreads = 0; // 弹性伸缩时最少保留的线程数，这些线程空闲超过 maxIdleTime 也不退出，0 表示与 threadCount 相同；启动时生效
+        size_t maxThreads = 0; // 弹性伸缩时最多的线程数，0 表示与 threadCount 相同（不扩容）；启动时生效
+        size_t targetQueueWait = 0; // 排队时间目标（毫秒），任务排队超过该时长、或排在已执行超过该时长的任务之后，且线程数未达 maxThreads 时扩容，0 表示不扩容；启动时生效
     };
 
     struct ThreadTask
@@ -78,7 +118,10 @@ namespace tbs::threads
 
         std::function<void()> task; // 任务函数
         int status = CREATED; // 任务状态
-        int priority = 0; // 任务优先级
+        int priority = 0; // 任务优先级，数值越小越先执行
+        CancellationToken token{}; // 取消令牌，出队时已取消的任务不再执行
+        uint64_t sequence = 0; // 提交序号，用于淘汰最早提交的任务
+        uint64_t enqueuedAt = 0; // 入队时的 CycleClock 读数，用于统计排队时间
 
         bool operator>=(const ThreadTask& __y) const
         {
@@ -86,8 +129,6 @@ namespace tbs::threads
         }
     };
 
-    class ThreadPoolImpl;
-
     /**
      * 线程池类
      * @note 线程池不支持拷贝，只支持移动
@@ -114,7 +155,12 @@ namespace tbs::threads
                             exception_handler exceptionHandler = nullptr,
                             thread_pool_event_handler eventHandler = nullptr);
 
-        DEFAULT_DESTRUCTION(ThreadPool); // 默认析构函数
+        /**
+         * 析构函数，线程池仍在运行时先停止，并等待所有工作线程退出
+         * @note 在实现文件中定义，保证析构时 ThreadPoolImpl 是完整类型
+         * @note 不能在本线程池的工作线程上析构（包括任务、异常处理函数与事件处理函数中），否则调用 std::terminate
+         */
+        ~ThreadPool() override;
 
         DELETE_COPY_ASSIGNMENT(ThreadPool); // 删除拷贝赋值操作
         DELETE_COPY_CONSTRUCTION(ThreadPool); // 删除拷贝构造函数
@@ -123,7 +169,8 @@ namespace tbs::threads
         DEFAULT_MOVE_CONSTRUCTION(ThreadPool); // 默认移动构造函数
 
         /**
-         * 停止线程池
+         * 停止线程池，阻塞到其他工作线程全部退出
+         * @note 可以在本线程池的任务或处理函数中调用：此时不等待调用者所在的工作线程，它在当前任务返回后退出
          */
         void stop();
 
@@ -133,11 +180,68 @@ namespace tbs::threads
         void start();
 
         /**
-         * 提交一个任务
+         * 提交一个任务，未完成任务数达到上限时按配置的 rejectPolicy 处理
+         * @param function 任务函数
+         * @param priority 任务优先级
+         * @return SUBMIT_ACCEPTED、SUBMIT_CALLER_RAN，或被拒绝时的 EXCEPTION_TASK_COUNT_FULL（同时调用异常处理器）
+         * @throws std::runtime_error 线程池未运行
+         */
+        int submit(std::function<void()> function, int priority = 0);
+
+        /**
+         * 提交一个可取消的任务，未完成任务数达到上限时按配置的 rejectPolicy 处理
+         * @param function 任务函数，运行中需要响应取消时自行轮询令牌
+         * @param token 取消令牌，任务出队时已取消则直接丢弃，并触发 CANCELED 事件
+         * @param priority 任务优先级
+         * @return SUBMIT_ACCEPTED、SUBMIT_CALLER_RAN，或被拒绝时的 EXCEPTION_TASK_COUNT_FULL（同时调用异常处理器）
+         * @throws std::runtime_error 线程池未运行
+         */
+        int submit(std::function<void()> function, CancellationToken token, int priority = 0);
+
+        /**
+         * 尝试提交一个任务，从不阻塞，也不执行 rejectPolicy
          * @param function 任务函数
          * @param priority 任务优先级
+         * @return SUBMIT_ACCEPTED；未完成任务数已达上限时返回 EXCEPTION_TASK_COUNT_FULL；线程池未运行时返回 EXCEPTION_NOT_RUNNING
          */
-        void submit(std::function<void()> function, int priority = 0);
+        int trySubmit(std::function<void()> function, int priority = 0);
+
+        /**
+         * 尝试提交一个可取消的任务，从不阻塞，也不执行 rejectPolicy
+         * @param function 任务函数
+         * @param token 取消令牌
+         * @param priority 任务优先级
+         * @return SUBMIT_ACCEPTED；未完成任务数已达上限时返回 EXCEPTION_TASK_COUNT_FULL；线程池未运行时返回 EXCEPTION_NOT_RUNNING
+         */
+        int trySubmit(std::function<void()> function, CancellationToken token, int priority = 0);
+
+        /**
+         * 提交一个任务，优先交给绑定在指定 NUMA 节点上的工作线程
+         * @param node NUMA 节点编号；未启用 PLACEMENT_SPREAD / PLACEMENT_PACK 或该节点上没有工作线程时与 submit 相同
+         * @param function 任务函数
+         * @param priority 任务优先级
+         * @return 与 submit 相同
+         * @throws std::runtime_error 线程池未运行
+         */
+        int submitToNode(int node, std::function<void()> function, int priority = 0);
+
+        /**
+         * 提交一个可取消的任务，优先交给绑定在指定 NUMA 节点上的工作线程
+         * @param node NUMA 节点编号；未启用 PLACEMENT_SPREAD / PLACEMENT_PACK 或该节点上没有工作线程时与 submit 相同
+         * @param function 任务函数
+         * @param token 取消令牌
+         * @param priority 任务优先级
+         * @return 与 submit 相同
+         * @throws std::runtime_error 线程池未运行
+         */
+        int submitToNode(int node, std::function<void()> function, CancellationToken token, int priority = 0);
+
+        /**
+         * 把协程切换到工作线程上继续执行：co_await pool.schedule()
+         * @param priority 恢复协程的任务的优先级
+         * @return 等待体，使用前需包含 tbs/threads/Coroutine.h
+         */
+        ScheduleAwaiter schedule(int priority = 0);
 
         /**
          * 获取线程池是否正在运行
@@ -145,6 +249,13 @@ namespace tbs::threads
          */
         bool isRunning() const;
 
+        /**
+         * 读取运行指标：各工作线程的计数、排队时间与执行时间直方图
+         * 计数和直方图由工作线程以 relaxed 原子操作就地累加，只有调用本函数时才汇总，不读取时几乎没有开销
+         * @return 指标快照，各项之间不保证严格一致
+         */
+        ThreadPoolSnapshot snapshot() const;
+
         /**
          * 获取线程池配置（常量版本）
          * @return 线程池配置
@@ -0,0 +1,228 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_THREADS_THREADPOOLMETRICS_H
+#define TBS_THREADS_THREADPOOLMETRICS_H
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include <tbs/defs.h>
+namespace tbs::threads
+{
+    /**
+     * 直方图快照，值的单位为纳秒
+     */
+    class HistogramSnapshot
+    {
+    public:
+        HistogramSnapshot() = default;
+
+        HistogramSnapshot(std::vector<uint64_t> counts, uint64_t sum) : _counts(std::move(counts)), _sum(sum)
+        {
+            for (uint64_t c : _counts)
+            {
+                _total += c;
+            }
+        }
+
+        /**
+         * 获取记录的值的个数
+         * @return 个数
+         */
+        uint64_t count() CONST
+        {
+            return _total;
+        }
+
+        /**
+         * 获取平均值
+         * @return 平均值，没有记录时为 0
+         */
+        double mean() CONST
+        {
+            return _total == 0 ? 0 : static_cast<double>(_sum) / static_cast<double>(_total);
+        }
+
+        /**
+         * 获取分位数
+         * @param p 分位，范围 [0, 100]
+         * @return 该分位所在桶的上界，相对误差不超过 1/16；没有记录时为 0
+         */
+        uint64_t percentile(double p) CONST;
+
+        /**
+         * 获取最大值所在桶的上界
+         * @return 最大值的近似，没有记录时为 0
+         */
+        uint64_t max() CONST
+        {
+            return percentile(100);
+        }
+
+        /**
+         * 合并另一个快照
+         * @param o 另一个快照
+         */
+        void merge(CONST HistogramSnapshot& o)
+        {
+            if (_counts.size() < o._counts.size())
+            {
+                _counts.resize(o._counts.size());
+            }
+            for (size_t i = 0; i < o._counts.size(); i++)
+            {
+                _counts[i] += o._counts[i];
+            }
+            _total += o._total;
+            _sum += o._sum;
+        }
+
+        /**
+         * 获取各桶的计数
+         * @return 各桶的计数，下标用 LatencyHistogram::lowerBound 换算为值
+         */
+        CONST std::vector<uint64_t>& counts() CONST
+        {
+            return _counts;
+        }
+
+    private:
+        std::vector<uint64_t> _counts;
+        uint64_t _total = 0;
+        uint64_t _sum = 0;
+    };
+
+    /**
+     * HDR 风格的对数线性直方图
+     * 每个 2 的幂区间分为 16 个等宽子桶，相对误差不超过 1/16，覆盖 [0, 2^40) 纳秒（约 18 分钟），更大的值计入最后一个桶。
+     * @note 只允许一个线程写入：记录是一次 relaxed 读加一次 relaxed 写，没有原子读改写；任意线程都可以随时读取快照
+     */
+    class LatencyHistogram
+    {
+    public:
+        constexpr static int SUB_BITS = 4; // 子桶数的位数
+        constexpr static uint64_t SUB_COUNT = 1ull << SUB_BITS; // 每个 2 的幂区间的子桶数
+        constexpr static int MAX_EXPONENT = 40; // 可记录的最大值为 2^MAX_EXPONENT - 1
+        constexpr static size_t BUCKETS = (MAX_EXPONENT - SUB_BITS + 1) * SUB_COUNT; // 桶数
+
+        /**
+         * 值所在的桶
+         * @param v 值
+         * @return 桶的下标
+         */
+        constexpr static size_t indexOf(uint64_t v)
+        {
+            v = std::min<uint64_t>(v, (1ull << MAX_EXPONENT) - 1);
+            if (v < 2 * SUB_COUNT)
+            {
+                return v;
+            }
+            int shift = std::bit_width(v) - 1 - SUB_BITS;
+            return (shift + 1) * SUB_COUNT + ((v >> shift) - SUB_COUNT);
+        }
+
+        /**
+         * 桶的下界
+         * @param index 桶的下标
+         * @return 桶中最小的值
+         */
+        constexpr static uint64_t lowerBound(size_t index)
+        {
+            if (index < 2 * SUB_COUNT)
+            {
+                return index;
+            }
+            int shift = static_cast<int>(index / SUB_COUNT) - 1;
+            return (index % SUB_COUNT + SUB_COUNT) << shift;
+        }
+
+        /**
+         * 桶的上界
+         * @param index 桶的下标
+         * @return 桶中最大的值
+         */
+        constexpr static uint64_t upperBound(size_t index)
+        {
+            return index + 1 < BUCKETS ? lowerBound(index + 1) - 1 : (1ull << MAX_EXPONENT) - 1;
+        }
+
+        /**
+         * 记录一个值，只能由唯一的写线程调用
+         * @param v 值
+         */
+        void record(uint64_t v)
+        {
+            auto& c = _counts[indexOf(v)];
+            c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            _sum.store(_sum.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+        }
+
+        /**
+         * 读取快照，与写入并发时各桶之间不保证一致
+         * @return 快照
+         */
+        HistogramSnapshot snapshot() CONST
+        {
+            std::vector<uint64_t> counts(BUCKETS);
+            for (size_t i = 0; i < BUCKETS; i++)
+            {
+                counts[i] = _counts[i].load(std::memory_order_relaxed);
+            }
+            return HistogramSnapshot(std::move(counts), _sum.load(std::memory_order_relaxed));
+        }
+
+    private:
+        std::array<std::atomic_uint64_t, BUCKETS> _counts{};
+        std::atomic_uint64_t _sum{0};
+    };
+
+    inline uint64_t HistogramSnapshot::percentile(double p) CONST
+    {
+        if (_total == 0)
+        {
+            return 0;
+        }
+        auto rank = static_cast<uint64_t>(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(_total));
+        rank = std::clamp<uint64_t>(rank, 1, _total);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < _counts.size(); i++)
+        {
+            seen += _counts[i];
+            if (seen >= rank)
+            {
+                return LatencyHistogram::upperBound(i);
+            }
+        }
+        return LatencyHistogram::upperBound(_counts.size() - 1);
+    }
+
+    /**
+     * 单个工作线程的计数
+     */
+    struct WorkerMetrics
+    {
+        uint64_t submitted = 0; // 提交到该线程队列的任务数
+        uint64_t completed = 0; // 该线程执行完成的任务数（含抛出异常的）
+        uint64_t rejected = 0; // 以该线程队列为目标但被拒绝、或从该队列中被淘汰的任务数
+        uint64_t stolen = 0; // 该线程从其他线程队列中窃取执行的任务数
+        uint64_t queueDepth = 0; // 读取时该线程队列中的任务数（近似值）
+    };
+
+    /**
+     * 线程池指标快照
+     */
+    struct ThreadPoolSnapshot
+    {
+        size_t threads = 0; // 读取时接收新任务的线程数
+        std::vector<WorkerMetrics> workers; // 各工作线程的计数，按线程索引，长度为线程数上限
+        WorkerMetrics total; // 各工作线程计数之和
+        HistogramSnapshot queueWait; // 任务从提交到开始执行的等待时间（纳秒）
+        HistogramSnapshot runTime; // 任务的执行时间（纳秒）
+    };
+} // namespace tbs::threads
+
+#endif // TBS_THREADS_THREADPOOLMETRICS_H
@@ -0,0 +1,162 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_THREADS_TIMERWHEEL_H
+#define TBS_THREADS_TIMERWHEEL_H
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <tbs/PointerToImpl.h>
+#include <tbs/threads/Cancellation.h>
+#include <tbs/threads/ThreadPool.h>
+#include <tbs/time_utils.hpp>
+namespace tbs::threads
+{
+    class TimerWheelImpl;
+} // namespace tbs::threads
+
+/**
+ * 在实现文件中特化，保证释放 TimerWheelImpl 时它是完整类型，析构函数一定会执行
+ */
+template <>
+void default_resetor<tbs::threads::TimerWheelImpl>(tbs::threads::TimerWheelImpl*& ptr);
+
+namespace tbs::threads
+{
+    /**
+     * 定时任务句柄，用于取消尚未执行的定时任务
+     * @note 句柄可以拷贝，所有拷贝共享同一个 CancellationSource
+     */
+    class TimerHandle
+    {
+    public:
+        TimerHandle() = default;
+
+        explicit TimerHandle(CancellationSource source) : _source(std::move(source))
+        {
+        }
+
+        /**
+         * 取消定时任务，O(1)
+         * @note 只置位标志：定时器线程在处理到任务所在的槽位时回收节点，已交给线程池但尚未执行的任务出队时丢弃
+         */
+        void cancel() CONST
+        {
+            if (_source.has_value())
+            {
+                _source->cancel();
+            }
+        }
+
+        /**
+         * 获取定时任务是否已取消
+         * @return 是否已取消
+         */
+        bool isCancelled() CONST
+        {
+            return _source.has_value() && _source->isCancelled();
+        }
+
+        /**
+         * 获取句柄是否关联了定时任务
+         * @return 是否有效
+         */
+        bool valid() CONST
+        {
+            return _source.has_value();
+        }
+
+        /**
+         * 获取定时任务的取消令牌，周期任务可在运行中轮询
+         * @return 取消令牌
+         */
+        CancellationToken token() CONST
+        {
+            return _source.has_value() ? _source->token() : CancellationToken();
+        }
+
+    private:
+        std::optional<CancellationSource> _source; // 取消源
+    };
+
+    /**
+     * 分层时间轮定时器
+     * 以 1 毫秒为一个刻度，第一层 256 个槽位，其余四层各 64 个槽位，覆盖 2^32 毫秒（约 49 天），更远的任务按最远刻度放置后逐层降级。
+     * 添加与取消都是 O(1)，由单个定时器线程推进，到期的任务交给线程池执行，可容纳百万级未到期的定时任务。
+     * @note 定时器不支持拷贝与移动，析构时停止定时器线程并丢弃未到期的任务
+     * @note 线程池必须比定时器存活更久；线程池未运行时到期的任务被丢弃
+     * @note 到期的任务不经过拒绝策略提交：线程池已满时一次性任务在下一个刻度重试，周期任务跳过本次执行，定时器线程不会被阻塞
+     */
+    class TimerWheel final : protected virtual PointerImpl<TimerWheelImpl>
+    {
+    public:
+        using steady_time_point = std::chrono::steady_clock::time_point;
+        using system_time_point = std::chrono::system_clock::time_point;
+
+        /**
+         * 构造函数，启动定时器线程
+         * @param pool 执行到期任务的线程池
+         */
+        explicit TimerWheel(ThreadPool& pool);
+
+        /**
+         * 析构函数，停止定时器线程
+         */
+        ~TimerWheel() override;
+
+        DELETE_COPY_ASSIGNMENT(TimerWheel); // 删除拷贝赋值操作
+        DELETE_COPY_CONSTRUCTION(TimerWheel); // 删除拷贝构造函数
+
+        /**
+         * 延迟一段时间后执行任务
+         * @param delay 延迟时间，按刻度向上取整，不会提前触发
+         * @param task 任务函数
+         * @param priority 提交到线程池时的优先级
+         * @return 定时任务句柄
+         */
+        TimerHandle scheduleAfter(time_utils::ms delay, std::function<void()> task, int priority = 0);
+
+        /**
+         * 在指定的单调时钟时刻执行任务
+         * @param when 执行时刻，早于当前时刻的任务在下一个刻度执行
+         * @param task 任务函数
+         * @param priority 提交到线程池时的优先级
+         * @return 定时任务句柄
+         */
+        TimerHandle scheduleAt(steady_time_point when, std::function<void()> task, int priority = 0);
+
+        /**
+         * 在指定的系统时钟时刻执行任务
+         * @param when 执行时刻，换算为相对当前的延迟，此后系统时间的调整不影响触发
+         * @param task 任务函数
+         * @param priority 提交到线程池时的优先级
+         * @return 定时任务句柄
+         */
+        TimerHandle scheduleAt(system_time_point when, std::function<void()> task, int priority = 0);
+
+        /**
+         * 周期性执行任务，直到句柄被取消
+         * @param period 周期，至少 1 毫秒
+         * @param task 任务函数
+         * @param initialDelay 首次执行前的延迟
+         * @param priority 提交到线程池时的优先级
+         * @return 定时任务句柄
+         * @note 下一次触发按计划时刻累加周期计算，不受任务执行耗时影响；定时器落后时不补发错过的周期
+         */
+        TimerHandle scheduleEvery(time_utils::ms period,
+                                  std::function<void()> task,
+                                  time_utils::ms initialDelay = time_utils::ms(0),
+                                  int priority = 0);
+
+        /**
+         * 获取时间轮中的定时任务数
+         * @return 定时任务数，包含已取消但尚未回收的任务
+         */
+        size_t size() const;
+    };
+} // namespace tbs::threads
+
+#endif // TBS_THREADS_TIMERWHEEL_H
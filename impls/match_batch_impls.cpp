@@ -0,0 +1,281 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <tbs/match/match_batch.h>
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TBS_MATCH_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace match_batch_detail;
+
+namespace
+{
+    template <typename T>
+    bool testCase(const BatchCase<T>& c, T v)
+    {
+        switch (c.op)
+        {
+            case BatchOp::EQUAL:
+                return v == c.bound;
+            case BatchOp::NOT_EQUAL:
+                return v != c.bound;
+            case BatchOp::GREATER:
+                return v > c.bound;
+            case BatchOp::GREATER_EQUAL:
+                return v > c.bound || v == c.bound;
+            case BatchOp::LESS:
+                return v < c.bound;
+            case BatchOp::LESS_EQUAL:
+                return v < c.bound || v == c.bound;
+            default:
+                return true;
+        }
+    }
+
+    template <typename T>
+    void classifyScalar(const T* values, size_t n, const BatchCase<T>* cases, size_t count, uint8_t* out)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t c = 0;
+            while (c < count && !testCase(cases[c], values[i]))
+            {
+                c++;
+            }
+            out[i] = static_cast<uint8_t>(c);
+        }
+    }
+
+#ifdef TBS_MATCH_SIMD_X86
+    /**
+     * 整数比较：无符号数先异或符号位转为有符号比较，只用 cmpgt / cmpeq 组合出六种关系。
+     */
+    template <typename T>
+    struct IntLanes
+    {
+        constexpr static size_t LANES = 32 / sizeof(T);
+        constexpr static bool IS_UNSIGNED = std::is_unsigned_v<T>;
+
+        __attribute__((target("avx2"))) static __m256i bias()
+        {
+            if constexpr (sizeof(T) == 4)
+            {
+                return _mm256_set1_epi32(IS_UNSIGNED ? INT32_MIN : 0);
+            }
+            else
+            {
+                return _mm256_set1_epi64x(IS_UNSIGNED ? INT64_MIN : 0);
+            }
+        }
+
+        __attribute__((target("avx2"))) static __m256i load(const T* p)
+        {
+            return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), bias());
+        }
+
+        __attribute__((target("avx2"))) static __m256i splat(T v)
+        {
+            if constexpr (sizeof(T) == 4)
+            {
+                return _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(v)), bias());
+            }
+            else
+            {
+                return _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(v)), bias());
+            }
+        }
+
+        __attribute__((target("avx2"))) static __m256i gt(__m256i a, __m256i b)
+        {
+            if constexpr (sizeof(T) == 4)
+            {
+                return _mm256_cmpgt_epi32(a, b);
+            }
+            else
+            {
+                return _mm256_cmpgt_epi64(a, b);
+            }
+        }
+
+        __attribute__((target("avx2"))) static __m256i eq(__m256i a, __m256i b)
+        {
+            if constexpr (sizeof(T) == 4)
+            {
+                return _mm256_cmpeq_epi32(a, b);
+            }
+            else
+            {
+                return _mm256_cmpeq_epi64(a, b);
+            }
+        }
+
+        __attribute__((target("avx2"))) static __m256i mask(BatchOp op, __m256i v, __m256i b)
+        {
+            const __m256i ones = _mm256_set1_epi32(-1);
+            switch (op)
+            {
+                case BatchOp::EQUAL:
+                    return eq(v, b);
+                case BatchOp::NOT_EQUAL:
+                    return _mm256_xor_si256(eq(v, b), ones);
+                case BatchOp::GREATER:
+                    return gt(v, b);
+                case BatchOp::GREATER_EQUAL:
+                    return _mm256_xor_si256(gt(b, v), ones);
+                case BatchOp::LESS:
+                    return gt(b, v);
+                case BatchOp::LESS_EQUAL:
+                    return _mm256_xor_si256(gt(v, b), ones);
+                default:
+                    return ones;
+            }
+        }
+    };
+
+    /**
+     * 浮点比较：与标量语义一致，含 NaN 时只有“不等于”成立。
+     */
+    template <typename T>
+    struct FloatLanes
+    {
+        constexpr static size_t LANES = 32 / sizeof(T);
+
+        __attribute__((target("avx2"))) static auto load(const T* p)
+        {
+            if constexpr (sizeof(T) == 4)
+            {
+                return _mm256_loadu_ps(p);
+            }
+            else
+            {
+                return _mm256_loadu_pd(p);
+            }
+        }
+
+        __attribute__((target("avx2"))) static auto splat(T v)
+        {
+            if constexpr (sizeof(T) == 4)
+            {
+                return _mm256_set1_ps(v);
+            }
+            else
+            {
+                return _mm256_set1_pd(v);
+            }
+        }
+
+        template <int PREDICATE, typename VEC>
+        __attribute__((target("avx2"))) static __m256i cmp(VEC a, VEC b)
+        {
+            if constexpr (sizeof(T) == 4)
+            {
+                return _mm256_castps_si256(_mm256_cmp_ps(a, b, PREDICATE));
+            }
+            else
+            {
+                return _mm256_castpd_si256(_mm256_cmp_pd(a, b, PREDICATE));
+            }
+        }
+
+        template <typename VEC>
+        __attribute__((target("avx2"))) static __m256i mask(BatchOp op, VEC v, VEC b)
+        {
+            switch (op)
+            {
+                case BatchOp::EQUAL:
+                    return cmp<_CMP_EQ_OQ>(v, b);
+                case BatchOp::NOT_EQUAL:
+                    return cmp<_CMP_NEQ_UQ>(v, b);
+                case BatchOp::GREATER:
+                    return cmp<_CMP_GT_OQ>(v, b);
+                case BatchOp::GREATER_EQUAL:
+                    return cmp<_CMP_GE_OQ>(v, b);
+                case BatchOp::LESS:
+                    return cmp<_CMP_LT_OQ>(v, b);
+                case BatchOp::LESS_EQUAL:
+                    return cmp<_CMP_LE_OQ>(v, b);
+                default:
+                    return _mm256_set1_epi32(-1);
+            }
+        }
+    };
+
+    template <typename T>
+    using LanesOf = std::conditional_t<std::is_floating_point_v<T>, FloatLanes<T>, IntLanes<T>>;
+
+    /**
+     * 把每个 32 / 64 位通道的最低字节（即分支序号）收拢写到 out。
+     */
+    template <size_t WIDTH>
+    __attribute__((target("avx2"))) void storeIndices(__m256i r, uint8_t* out)
+    {
+        if constexpr (WIDTH == 4)
+        {
+            const __m256i shuffle = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4,
+                                                     8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            __m256i s = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(r, shuffle), _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(s));
+        }
+        else
+        {
+            const __m256i shuffle = _mm256_setr_epi8(0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 8,
+                                                     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            __m256i s = _mm256_shuffle_epi8(r, shuffle);
+            uint32_t packed = static_cast<uint32_t>(_mm256_extract_epi16(s, 0)) | (static_cast<uint32_t>(_mm256_extract_epi16(s, 8)) << 16);
+            std::memcpy(out, &packed, 4);
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) void classifyAvx2(const T* values, size_t n, const BatchCase<T>* cases, size_t count, uint8_t* out)
+    {
+        using L = LanesOf<T>;
+        constexpr size_t LANES = L::LANES;
+        const __m256i none = sizeof(T) == 4 ? _mm256_set1_epi32(static_cast<int>(count)) : _mm256_set1_epi64x(static_cast<long long>(count));
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES)
+        {
+            auto v = L::load(values + i);
+            __m256i r = none;
+            // 逆序处理，靠前的分支最后写入，从而优先
+            for (size_t c = count; c-- > 0;)
+            {
+                __m256i hit = L::mask(cases[c].op, v, L::splat(cases[c].bound));
+                __m256i index = sizeof(T) == 4 ? _mm256_set1_epi32(static_cast<int>(c)) : _mm256_set1_epi64x(static_cast<long long>(c));
+                r = _mm256_blendv_epi8(r, index, hit);
+            }
+            storeIndices<sizeof(T)>(r, out + i);
+        }
+        classifyScalar(values + i, n - i, cases, count, out + i);
+    }
+#endif
+} // namespace
+
+template <BatchElement T>
+void match_batch_detail::classify(const T* values, size_t n, const BatchCase<T>* cases, size_t count, uint8_t* out)
+{
+    using Kernel = void (*)(const T*, size_t, const BatchCase<T>*, size_t, uint8_t*);
+    static const Kernel kernel = []() -> Kernel
+    {
+#ifdef TBS_MATCH_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return &classifyAvx2<T>;
+        }
+#endif
+        return &classifyScalar<T>;
+    }();
+    kernel(values, n, cases, count, out);
+}
+
+template void match_batch_detail::classify<int32_t>(const int32_t*, size_t, const BatchCase<int32_t>*, size_t, uint8_t*);
+template void match_batch_detail::classify<uint32_t>(const uint32_t*, size_t, const BatchCase<uint32_t>*, size_t, uint8_t*);
+template void match_batch_detail::classify<int64_t>(const int64_t*, size_t, const BatchCase<int64_t>*, size_t, uint8_t*);
+template void match_batch_detail::classify<uint64_t>(const uint64_t*, size_t, const BatchCase<uint64_t>*, size_t, uint8_t*);
+template void match_batch_detail::classify<float>(const float*, size_t, const BatchCase<float>*, size_t, uint8_t*);
+template void match_batch_detail::classify<double>(const double*, size_t, const BatchCase<double>*, size_t, uint8_t*);
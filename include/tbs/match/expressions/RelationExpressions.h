@@ -33,6 +33,7 @@ public:
  * 它提供了一个模板函数来比较两个不同类型的值是否不相等
  */
 class NotEqualMatchExpression {
+public:
   /**
    * 模板函数test用于判断两个值是否不相等
    * @param target 目标值
@@ -48,6 +49,7 @@ class NotEqualMatchExpression {
  * 它提供了一个模板函数来判断第一个值是否大于第二个值
  */
 class GreaterThanMatchExpression {
+public:
   /**
    * 模板函数test用于判断目标值是否大于另一个值
    * @param target 目标值
@@ -63,6 +65,7 @@ class GreaterThanMatchExpression {
  * 它提供了一个模板函数来判断第一个值是否大于或等于第二个值
  */
 class GreaterThanOrEqualMatchExpression {
+public:
   /**
    * 模板函数test用于判断目标值是否大于或等于另一个值
    * @param target 目标值
@@ -78,6 +81,7 @@ class GreaterThanOrEqualMatchExpression {
  * 它提供了一个模板函数来判断第一个值是否小于第二个值
  */
 class LessThanMatchExpression {
+public:
   /**
    * 模板函数test用于判断目标值是否小于另一个值
    * @param target 目标值
@@ -93,6 +97,7 @@ class LessThanMatchExpression {
  * 它提供了一个模板函数来判断第一个值是否小于或等于第二个值
  */
 class LessThanOrEqualMatchExpression {
+public:
   /**
    * 模板函数test用于判断目标值是否小于或等于另一个值
    * @param target 目标值
@@ -0,0 +1,223 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_INCLUDE_MATCH_MATCH_BATCH_H
+#define TBS_TOOL_LIB_INCLUDE_MATCH_MATCH_BATCH_H
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <tbs/defs.h>
+#include <tbs/match/matchers.h>
+
+namespace match_batch_detail
+{
+    /**
+     * @brief 可向量化的关系运算
+     */
+    enum class BatchOp : uint8_t
+    {
+        EQUAL,
+        NOT_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        ANY
+    };
+
+    /**
+     * @brief 一个分支的关系运算与比较值
+     */
+    template <typename T>
+    struct BatchCase
+    {
+        BatchOp op;
+        T bound;
+    };
+
+    /**
+     * @brief 有向量化内核的元素类型
+     */
+    template <typename T>
+    concept BatchElement = std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, int64_t> ||
+                           std::is_same_v<T, uint64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    /**
+     * @brief 向量化分类内核：out[i] 为第一个命中 values[i] 的分支序号，全部未命中时为 count
+     *
+     * 运行时检测 CPU，支持 AVX2 时一次比较 8 个 32 位或 4 个 64 位元素，否则使用标量循环。
+     *
+     * @param values 待分类的值
+     * @param n 值的个数
+     * @param cases 分支列表
+     * @param count 分支个数，必须小于 255
+     * @param out 输出的分支序号
+     */
+    template <BatchElement T>
+    void classify(const T* values, size_t n, const BatchCase<T>* cases, size_t count, uint8_t* out);
+
+    template <typename E>
+    struct OpOf
+    {
+        constexpr static bool vectorizable = false;
+    };
+
+#define TBS_MATCH_BATCH_OP(EXPRESSION, OP)                                                                             \
+    template <>                                                                                                        \
+    struct OpOf<EXPRESSION>                                                                                            \
+    {                                                                                                                  \
+        constexpr static bool vectorizable = true;                                                                     \
+        constexpr static BatchOp op = BatchOp::OP;                                                                     \
+    };
+
+    TBS_MATCH_BATCH_OP(EqualMatchExpression, EQUAL)
+    TBS_MATCH_BATCH_OP(NotEqualMatchExpression, NOT_EQUAL)
+    TBS_MATCH_BATCH_OP(GreaterThanMatchExpression, GREATER)
+    TBS_MATCH_BATCH_OP(GreaterThanOrEqualMatchExpression, GREATER_EQUAL)
+    TBS_MATCH_BATCH_OP(LessThanMatchExpression, LESS)
+    TBS_MATCH_BATCH_OP(LessThanOrEqualMatchExpression, LESS_EQUAL)
+    TBS_MATCH_BATCH_OP(AnyMatchExpression, ANY)
+
+#undef TBS_MATCH_BATCH_OP
+
+    template <typename M>
+    struct MatcherTraits
+    {
+        template <typename T>
+        constexpr static bool vectorizable = false;
+    };
+
+    template <typename V, typename E, typename F>
+    struct MatcherTraits<Matcher<V, E, F>>
+    {
+        // 标量路径按混合类型比较，把边界转换成值类型可能截断或舍入，所以只有类型相同时才向量化
+        template <typename T>
+        constexpr static bool vectorizable =
+            OpOf<E>::vectorizable && (std::is_same_v<E, AnyMatchExpression> || std::is_same_v<std::remove_cv_t<V>, T>);
+
+        template <typename T>
+        static BatchCase<T> toCase(const Matcher<V, E, F>& m)
+        {
+            if constexpr (OpOf<E>::op == BatchOp::ANY)
+            {
+                return {BatchOp::ANY, T()};
+            }
+            else
+            {
+                return {OpOf<E>::op, static_cast<T>(m.value())};
+            }
+        }
+    };
+
+    template <typename M>
+    using traits_of = MatcherTraits<std::remove_cvref_t<M>>;
+
+    template <typename T, typename TUPLE, typename OUT, size_t... I>
+    void scalar(std::span<const T> values, TUPLE& all, std::span<OUT> out, std::index_sequence<I...>)
+    {
+        constexpr size_t N = sizeof...(I);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            size_t index = N;
+            ((std::get<I>(all).test(values[i]) ? (index = I, true) : false) || ...);
+            out[i] = static_cast<OUT>(index);
+        }
+    }
+
+    template <typename T, typename TUPLE, typename OUT, size_t... I>
+    void vectorized(std::span<const T> values, TUPLE& all, std::span<OUT> out, std::index_sequence<I...>)
+    {
+        constexpr size_t N = sizeof...(I);
+        const std::array<BatchCase<T>, N> cases = {traits_of<std::tuple_element_t<I, TUPLE>>::template toCase<T>(std::get<I>(all))...};
+        if constexpr (sizeof(OUT) == 1)
+        {
+            classify(values.data(), values.size(), cases.data(), N, reinterpret_cast<uint8_t*>(out.data()));
+        }
+        else
+        {
+            // 分块写入字节缓冲，再拓宽到输出类型
+            constexpr size_t CHUNK = 1024;
+            uint8_t buffer[CHUNK];
+            for (size_t i = 0; i < values.size(); i += CHUNK)
+            {
+                size_t n = std::min(CHUNK, values.size() - i);
+                classify(values.data() + i, n, cases.data(), N, buffer);
+                for (size_t j = 0; j < n; j++)
+                {
+                    out[i + j] = static_cast<OUT>(buffer[j]);
+                }
+            }
+        }
+    }
+
+    template <typename T, typename... ARGS>
+    auto prepare(std::span<const T> values, ARGS&... args)
+    {
+        static_assert(sizeof...(ARGS) >= 1, "matchBatch: missing output");
+        constexpr size_t N = sizeof...(ARGS) - 1;
+        static_assert(N < UINT8_MAX, "matchBatch: too many matchers");
+        std::tuple<ARGS&...> all(args...);
+        std::span out(std::get<N>(all));
+        static_assert(std::is_integral_v<typename decltype(out)::element_type>, "matchBatch: output must be integral");
+        if (out.size() < values.size())
+        {
+            throw tbs::base_error("matchBatch: output is smaller than input");
+        }
+        return std::make_pair(all, out);
+    }
+} // namespace match_batch_detail
+
+/**
+ * @brief 逐个值按顺序测试匹配器的批量分类（标量实现），适用于任意匹配器
+ *
+ * @tparam T 值的类型
+ * @tparam ARGS 匹配器的类型列表，最后一个为输出
+ * @param values 待分类的值
+ * @param args 匹配器列表，最后一个为输出的分支序号数组（span / vector / array），长度不小于 values
+ * @throws tbs::base_error 输出长度不足时抛出
+ */
+template <typename T, typename... ARGS>
+void matchBatchScalar(std::span<const T> values, ARGS&&... args)
+{
+    auto [all, out] = match_batch_detail::prepare(values, args...);
+    match_batch_detail::scalar(values, all, out, std::make_index_sequence<sizeof...(ARGS) - 1>{});
+}
+
+/**
+ * @brief 批量分类：对每个值求出第一个命中的匹配器序号，全部未命中时为匹配器个数
+ *
+ * 只做分类，不调用匹配器的处理函数，调用方可按输出的序号再分派。
+ * 值类型为 int32 / uint32 / int64 / uint64 / float / double，且匹配器都是边界类型与值类型相同的相等、不等、大于、大于等于、
+ * 小于、小于等于匹配器或任意匹配器时，整段数组用 SIMD 比较：每个分支一次向量比较加一次混合，
+ * 分支按逆序处理，使靠前的分支覆盖靠后的分支。其他情况退化为 matchBatchScalar。
+ *
+ * @tparam T 值的类型
+ * @tparam ARGS 匹配器的类型列表，最后一个为输出
+ * @param values 待分类的值
+ * @param args 匹配器列表（少于 255 个），最后一个为输出的分支序号数组（span / vector / array），长度不小于 values
+ * @throws tbs::base_error 输出长度不足时抛出
+ */
+template <typename T, typename... ARGS>
+void matchBatch(std::span<const T> values, ARGS&&... args)
+{
+    using namespace match_batch_detail;
+    auto [all, out] = prepare(values, args...);
+    using TUPLE = decltype(all);
+    constexpr auto CASES = std::make_index_sequence<sizeof...(ARGS) - 1>{};
+    constexpr bool vectorizable = []<size_t... I>(std::index_sequence<I...>)
+    { return (traits_of<std::tuple_element_t<I, TUPLE>>::template vectorizable<std::remove_cv_t<T>> && ...); }(CASES);
+    if constexpr (BatchElement<std::remove_cv_t<T>> && vectorizable)
+    {
+        vectorized(values, all, out, CASES);
+    }
+    else
+    {
+        scalar(values, all, out, CASES);
+    }
+}
+
+#endif // TBS_TOOL_LIB_INCLUDE_MATCH_MATCH_BATCH_H
@@ -6,6 +6,7 @@
 #define TBS_TOOL_LIB_INCLUDE_MATCH_MATCH_MACRO_H
 
 #include "matchers.h"
+#include "switch_match.h"
 
 /**
  * @brief 定义一个宏，用于创建一个可以匹配任何值的匹配器。
@@ -22,6 +23,14 @@
  */
 #define EQUAL_MATCH(val, f) make_equal_matcher(val, [&](const auto& _target_, const decltype(val) & _v_) -> auto { f })
 
+/**
+ * @brief 定义一个宏，用于创建一个键为编译期常量的匹配器，供 SWITCH_MATCH 构建跳转表。
+ *
+ * @param key 常量键，整数 / 枚举字面量或 make_ConstexprValue("...")
+ * @param f 匹配逻辑的 lambda 表达式
+ */
+#define CASE_MATCH(key, f) make_case_matcher<key>([&](const auto& _target_, const auto& _v_) -> auto { f })
+
 /**
  * @brief 定义一个宏，用于创建一个基于函数的匹配器。
  *
@@ -48,6 +57,15 @@
  */
 #define RETURNED_MATCH(val, cases, _else) match(val, cases, []() { _else })
 
+/**
+ * @brief 定义一个宏，用于创建一个在编译期选择分派策略（跳转表 / 二分查找 / 完美哈希）的匹配逻辑。
+ *
+ * @param val 要匹配的值
+ * @param cases 匹配逻辑的 case 列表
+ * @param _else 默认情况下执行的逻辑
+ */
+#define SWITCH_MATCH(val, cases, _else) switchMatch(val, cases, []() { _else })
+
 /**
  * @brief 定义一个模板函数，用于将一个值与一个匹配器进行匹配。
  *
@@ -88,6 +106,7 @@ void matchWithoutReturn(CONST T& v, F&& f, E&& e)
     if (f.test(v))
     {
         f(v);
+        return;
     }
     e();
 }
@@ -100,6 +100,16 @@ public:
         return _equals.test(t, _value);
     }
 
+    /**
+     * @brief 获取内部存储的值
+     *
+     * @return 内部存储的值的常量引用
+     */
+    const V& value() const
+    {
+        return _value;
+    }
+
     /**
      * @brief 处理函数
      *
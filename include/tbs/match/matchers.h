@@ -68,4 +68,32 @@ FunctionalMatcher<F, E> make_functional_matcher(F &&f, E &&e) {
 }
 
 
+// 创建关系匹配器（不等于、大于、大于等于、小于、小于等于），用于区间分类，可交给 matchBatch 批量向量化匹配
+// 参数t是用于比较的值，f是一个可调用对象，用于执行匹配操作
+template<typename T, typename F>
+NotEqualMatcher<std::decay_t<T>, F> make_not_equal_matcher(T &&t, F &&f) {
+    return NotEqualMatcher<std::decay_t<T>, F>(std::forward<T>(t), f);
+}
+
+template<typename T, typename F>
+GreaterThanMatcher<std::decay_t<T>, F> make_greater_than_matcher(T &&t, F &&f) {
+    return GreaterThanMatcher<std::decay_t<T>, F>(std::forward<T>(t), f);
+}
+
+template<typename T, typename F>
+GreaterThanOrEqualMatcher<std::decay_t<T>, F> make_greater_than_or_equal_matcher(T &&t, F &&f) {
+    return GreaterThanOrEqualMatcher<std::decay_t<T>, F>(std::forward<T>(t), f);
+}
+
+template<typename T, typename F>
+LessThanMatcher<std::decay_t<T>, F> make_less_than_matcher(T &&t, F &&f) {
+    return LessThanMatcher<std::decay_t<T>, F>(std::forward<T>(t), f);
+}
+
+template<typename T, typename F>
+LessThanOrEqualMatcher<std::decay_t<T>, F> make_less_than_or_equal_matcher(T &&t, F &&f) {
+    return LessThanOrEqualMatcher<std::decay_t<T>, F>(std::forward<T>(t), f);
+}
+
+
 #endif //TBS_TOOL_LIB_INCLUDE_MATCH_MATCHERS_H
@@ -0,0 +1,340 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TOOL_LIB_INCLUDE_MATCH_SWITCH_MATCH_H
+#define TBS_TOOL_LIB_INCLUDE_MATCH_SWITCH_MATCH_H
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <tbs/defs.h>
+#include <tbs/constexpr_hash.h>
+#include <tbs/constexpr_value.h>
+
+/**
+ * @brief 键为编译期常量的相等匹配器
+ *
+ * 与 EqualableMatcher 的语义相同，但键作为模板参数给出，switchMatch 可以据此在编译期构建跳转表。
+ * 整数与枚举键直接写字面量，字符串键使用 make_ConstexprValue("...")。
+ *
+ * @tparam KEY 要匹配的常量键
+ * @tparam F 用户定义的处理函数对象的类型
+ */
+template <auto KEY, typename F>
+class CaseMatcher
+{
+public:
+    explicit CaseMatcher(F f) : _f(f)
+    {
+    }
+
+    /**
+     * @brief 常量键
+     */
+    constexpr static auto key = KEY;
+
+    /**
+     * @brief 测试给定的值是否等于常量键
+     *
+     * @tparam T 给定值的类型
+     * @param t 给定的值
+     * @return 相等返回 true，否则返回 false
+     */
+    template <typename T>
+    bool test(const T& t) const
+    {
+        return KEY == t;
+    }
+
+    /**
+     * @brief 使用用户定义的处理函数处理给定的值
+     *
+     * @tparam T 给定值的类型
+     * @param t 给定的值
+     * @return 处理结果
+     */
+    template <typename T>
+    auto operator()(const T& t) const
+    {
+        return _f(t, KEY);
+    }
+
+private:
+    F _f; // 用户定义的处理函数对象
+};
+
+/**
+ * @brief 创建一个键为编译期常量的匹配器
+ *
+ * @tparam KEY 常量键
+ * @tparam F 处理函数的类型
+ * @param f 处理函数
+ * @return CaseMatcher 对象
+ */
+template <auto KEY, typename F>
+CaseMatcher<KEY, F> make_case_matcher(F&& f)
+{
+    return CaseMatcher<KEY, F>(f);
+}
+
+namespace switch_match_detail
+{
+    template <typename C>
+    struct CaseTraits
+    {
+        constexpr static bool isCase = false;
+        constexpr static bool isIntegral = false;
+        constexpr static bool isString = false;
+    };
+
+    template <auto KEY, typename F>
+    struct CaseTraits<CaseMatcher<KEY, F>>
+    {
+        using key_type = std::remove_cv_t<decltype(KEY)>;
+        constexpr static bool isCase = true;
+        constexpr static bool isIntegral = std::is_integral_v<key_type> || std::is_enum_v<key_type>;
+        constexpr static bool isString = requires {
+            { KEY.to_string_view() } -> std::convertible_to<std::string_view>;
+        };
+    };
+
+    template <typename T>
+    struct Underlying
+    {
+        using type = T;
+    };
+
+    template <typename T>
+        requires std::is_enum_v<T>
+    struct Underlying<T>
+    {
+        using type = std::underlying_type_t<T>;
+    };
+
+    /**
+     * 字符类型与 bool 不能用于 std::in_range 与 std::make_unsigned，换成同宽度、同符号的标准整数类型
+     */
+    template <typename T>
+    struct Standard
+    {
+        using type = std::conditional_t<std::is_signed_v<T>, std::make_signed_t<T>, std::make_unsigned_t<T>>;
+    };
+
+    template <>
+    struct Standard<bool>
+    {
+        using type = unsigned char;
+    };
+
+    /**
+     * 整数、字符、bool 与枚举统一转为标准整数类型后比较
+     */
+    template <typename T>
+    using underlying_t = typename Standard<typename Underlying<T>::type>::type;
+
+    /**
+     * 键的取值跨度不超过键数的 DENSITY 倍时视为稠密，使用跳转表
+     */
+    constexpr size_t DENSITY = 4;
+
+    template <typename V, typename... CASES>
+    struct IntegralDispatch
+    {
+        using U = underlying_t<V>;
+        using UU = std::make_unsigned_t<U>;
+        constexpr static size_t N = sizeof...(CASES);
+        using index_type = std::conditional_t<(N < UINT8_MAX), uint8_t, uint16_t>;
+        static_assert(N < UINT16_MAX, "switchMatch: too many cases");
+
+        template <typename C>
+        constexpr static U keyOf()
+        {
+            using K = typename CaseTraits<C>::key_type;
+            constexpr auto raw = static_cast<underlying_t<K>>(C::key);
+            static_assert(std::in_range<U>(raw), "switchMatch: case key does not fit the matched type");
+            return static_cast<U>(raw);
+        }
+
+        constexpr static std::array<U, N> KEYS = {keyOf<CASES>()...};
+
+        constexpr static bool distinct()
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                for (size_t j = i + 1; j < N; j++)
+                {
+                    if (KEYS[i] == KEYS[j])
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static_assert(distinct(), "switchMatch: duplicate case key");
+
+        constexpr static U MIN = *std::min_element(KEYS.begin(), KEYS.end());
+        constexpr static U MAX = *std::max_element(KEYS.begin(), KEYS.end());
+        constexpr static uint64_t SPAN = static_cast<uint64_t>(static_cast<UU>(static_cast<UU>(MAX) - static_cast<UU>(MIN))) + 1;
+        constexpr static bool DENSE = SPAN <= N * DENSITY;
+
+        /**
+         * 稠密键：以 (值 - MIN) 为下标的表，未命中的槽位为 N
+         */
+        constexpr static auto JUMP_TABLE = []()
+        {
+            std::array<index_type, DENSE ? SPAN : 1> table{};
+            if constexpr (DENSE)
+            {
+                table.fill(static_cast<index_type>(N));
+                for (size_t i = 0; i < N; i++)
+                {
+                    table[static_cast<UU>(static_cast<UU>(KEYS[i]) - static_cast<UU>(MIN))] = static_cast<index_type>(i);
+                }
+            }
+            return table;
+        }();
+
+        /**
+         * 稀疏键：按键排序的 (键, 分支序号) 表，二分查找
+         */
+        constexpr static auto SORTED = []()
+        {
+            std::array<std::pair<U, index_type>, N> sorted{};
+            for (size_t i = 0; i < N; i++)
+            {
+                sorted[i] = {KEYS[i], static_cast<index_type>(i)};
+            }
+            std::sort(sorted.begin(), sorted.end());
+            return sorted;
+        }();
+
+        static size_t indexOf(const V& v)
+        {
+            U u = static_cast<U>(v);
+            if constexpr (DENSE)
+            {
+                uint64_t off = static_cast<UU>(static_cast<UU>(u) - static_cast<UU>(MIN));
+                return off < SPAN ? JUMP_TABLE[off] : N;
+            }
+            else
+            {
+                auto it = std::lower_bound(SORTED.begin(), SORTED.end(), u, [](const auto& e, U k) { return e.first < k; });
+                return it != SORTED.end() && it->first == u ? it->second : N;
+            }
+        }
+    };
+
+    template <typename... CASES>
+    struct StringDispatch
+    {
+        constexpr static size_t N = sizeof...(CASES);
+
+        constexpr static ConstexprPerfectHashMap<std::string_view, uint32_t, N> TABLE = []()
+        {
+            std::array<std::pair<std::string_view, uint32_t>, N> entries{};
+            uint32_t i = 0;
+            ((entries[i] = {CASES::key.to_string_view(), i}, i++), ...);
+            return ConstexprPerfectHashMap<std::string_view, uint32_t, N>(entries);
+        }();
+
+        static size_t indexOf(std::string_view v)
+        {
+            CONST uint32_t* i = TABLE.find(v);
+            return i == nullptr ? N : *i;
+        }
+    };
+
+    template <typename R, size_t I, typename T, typename TUPLE>
+    R invokeCase(const T& v, TUPLE& all)
+    {
+        return std::get<I>(all)(v);
+    }
+
+    template <typename R, typename T, typename TUPLE, size_t... I>
+    R dispatch(size_t index, const T& v, TUPLE& all, std::index_sequence<I...>)
+    {
+        constexpr size_t N = sizeof...(I);
+        // 分支序号到处理函数的跳转表，最后一项为默认逻辑
+        constexpr static std::array<R (*)(const T&, TUPLE&), N + 1> handlers = {
+            &invokeCase<R, I, T, TUPLE>...,
+            [](const T&, TUPLE& a) -> R { return std::get<N>(a)(); }};
+        return handlers[index](v, all);
+    }
+
+    template <typename R, typename T, typename TUPLE, size_t... I>
+    R linear(const T& v, TUPLE& all, std::index_sequence<I...>)
+    {
+        constexpr size_t N = sizeof...(I);
+        size_t index = N;
+        ((std::get<I>(all).test(v) ? (index = I, true) : false) || ...);
+        return dispatch<R>(index, v, all, std::index_sequence<I...>{});
+    }
+} // namespace switch_match_detail
+
+/**
+ * @brief 按编译期选择的策略将一个值与多个匹配器进行匹配
+ *
+ * 语义与 match 相同（按顺序取第一个命中的匹配器，全部未命中时执行默认逻辑），但在编译期检查分支类型：
+ * - 全部为整数 / 枚举键的 CaseMatcher 且键稠密时，计算 (值 - 最小键) 查跳转表，O(1)；
+ * - 全部为整数 / 枚举键的 CaseMatcher 且键稀疏时，在编译期排序的键表上二分查找；
+ * - 全部为字符串键的 CaseMatcher 时，使用编译期构建的完美哈希表；
+ * - 其他情况（含运行期键的 EqualableMatcher、关系匹配器等）退化为按顺序逐个测试。
+ * 分支序号确定后通过函数指针表直接跳到对应的处理函数。使用跳转表时重复的键是编译错误。
+ *
+ * @tparam T 输入值的类型
+ * @tparam ARGS 匹配器的类型列表，最后一个为默认逻辑
+ * @param v 输入值
+ * @param args 匹配器列表，最后一个为默认逻辑
+ * @return 命中的匹配器或默认逻辑的结果，各分支结果取公共类型
+ */
+template <typename T, typename... ARGS>
+auto switchMatch(CONST T& v, ARGS&&... args)
+{
+    using namespace switch_match_detail;
+    static_assert(sizeof...(ARGS) >= 1, "switchMatch: missing default branch");
+    constexpr size_t N = sizeof...(ARGS) - 1;
+    using TUPLE = std::tuple<ARGS&...>;
+    TUPLE all(args...);
+    using CASES = std::make_index_sequence<N>;
+
+    using R = decltype([]<size_t... I>(std::index_sequence<I...>)
+                       {
+                           return std::type_identity<std::common_type_t<
+                               decltype(std::declval<std::tuple_element_t<I, TUPLE>>()(std::declval<const T&>()))...,
+                               decltype(std::declval<std::tuple_element_t<N, TUPLE>>()())>>{};
+                       }(CASES{}))::type;
+
+    constexpr bool allCases = []<size_t... I>(std::index_sequence<I...>)
+    { return N > 0 && (CaseTraits<std::remove_cvref_t<std::tuple_element_t<I, TUPLE>>>::isCase && ...); }(CASES{});
+
+    if constexpr (allCases && (std::is_integral_v<T> || std::is_enum_v<T>) &&
+                  []<size_t... I>(std::index_sequence<I...>)
+                  { return (CaseTraits<std::remove_cvref_t<std::tuple_element_t<I, TUPLE>>>::isIntegral && ...); }(CASES{}))
+    {
+        size_t index = []<size_t... I>(std::index_sequence<I...>, const T& value)
+        { return IntegralDispatch<T, std::remove_cvref_t<std::tuple_element_t<I, TUPLE>>...>::indexOf(value); }(CASES{}, v);
+        return dispatch<R>(index, v, all, CASES{});
+    }
+    else if constexpr (allCases && std::is_convertible_v<const T&, std::string_view> &&
+                       []<size_t... I>(std::index_sequence<I...>)
+                       { return (CaseTraits<std::remove_cvref_t<std::tuple_element_t<I, TUPLE>>>::isString && ...); }(CASES{}))
+    {
+        size_t index = []<size_t... I>(std::index_sequence<I...>, std::string_view value)
+        { return StringDispatch<std::remove_cvref_t<std::tuple_element_t<I, TUPLE>>...>::indexOf(value); }(CASES{}, v);
+        return dispatch<R>(index, v, all, CASES{});
+    }
+    else
+    {
+        return linear<R>(v, all, CASES{});
+    }
+}
+
+#endif // TBS_TOOL_LIB_INCLUDE_MATCH_SWITCH_MATCH_H
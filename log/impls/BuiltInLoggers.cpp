@@ -17,18 +17,14 @@ static std::mutex _log_mx;
 
 void BuiltInLoggers::ConsoleLogger::log(const LogLevel& level, const char* str) const
 {
-    auto now = time_utils::utils_now();
+    char stamp[time_utils::TimestampFormatter::MAX_LENGTH];
+    time_utils::TimestampFormatter::standard().format(time_utils::utils_now_coarse(), stamp, sizeof(stamp));
     tbs::sys_unique_lock g(_log_mx);
     printf("%s", logLevelToColor[level - 1]);
     printf("%s", LOG_FORMAT("{} {}:  CONTENT : ", getLoggerName(), logLevelToString[level]).c_str()); // 输出日志级别
     printf("%s", "\x1B[4m");
     printf("%s", str); // 输出日志内容
-    printf("\x1B[0m %s %s",
-           logLevelToColor[level - 1],
-           LOG_FORMAT(" ;LOG_TIME: [ {}.{} ];",
-                      time_utils::outputTime(now),
-                      (double)(time_utils::as<time_utils::ms>(now) % 1000) / 1000.0 * 1000)
-               .c_str()); // 输出日志时间
+    printf("\x1B[0m %s  ;LOG_TIME: [ %s ];", logLevelToColor[level - 1], stamp); // 输出日志时间
     printf("\n\x1B[0m"); // 还原日志颜色并换行
     fflush(stdout);
 }
@@ -48,11 +44,11 @@ BuiltInLoggers::SimpleFileLogger::SimpleFileLogger(const std::string& name, cons
 
 void BuiltInLoggers::SimpleFileLogger::log(const LogLevel& level, const char* str) const
 {
+    char stamp[time_utils::TimestampFormatter::MAX_LENGTH];
     tbs::sys_unique_lock g(_log_mx);
-    auto now = time_utils::utils_now();
-    _file << LOG_FORMAT("At:{}.{:04d} {} [{}] Content: {} ;\n",
-                        time_utils::outputTime(now),
-                        std::chrono::duration_cast<std::chrono::milliseconds>(time_utils::standard_time(now)).count() % 1000,
+    time_utils::TimestampFormatter::standard().format(time_utils::utils_now_coarse(), stamp, sizeof(stamp));
+    _file << LOG_FORMAT("At:{} {} [{}] Content: {} ;\n",
+                        stamp,
                         _name,
                         logLevelToString[level],
                         str);
@@ -0,0 +1,210 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <tbs/concurrency/containers/ConcurrentAgingQueue.h>
+#include <tbs/threads/ThreadPool.h>
+
+#include "test_check.h"
+
+namespace
+{
+    using tbs::concurrency::containers::ConcurrentAgingQueue;
+    using namespace tbs::threads;
+
+    /**
+     * 单线程线程池中记录任务的执行顺序与被淘汰、被拒绝的任务
+     */
+    struct DropFixture
+    {
+        std::mutex mutex;
+        std::vector<int> ran; // 按执行顺序排列的任务编号
+        std::vector<int> dropped; // 被淘汰任务的优先级
+        std::atomic_int rejected{0};
+        std::atomic_bool started{false};
+        std::atomic_bool gate{false};
+        ThreadPool pool;
+
+        DropFixture(int policy, size_t agingInterval) : pool("drop-test", 1, 4, 1, 60000, handler())
+        {
+            pool.getConfig().rejectPolicy = policy;
+            pool.getConfig().priorityAgingInterval = agingInterval;
+            pool.start();
+            // 占住唯一的工作线程，之后提交的任务都留在队列里
+            pool.submit(
+                [this]()
+                {
+                    started = true;
+                    while (!gate.load())
+                    {
+                        std::this_thread::yield();
+                    }
+                });
+            while (!started.load())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        exception_handler handler()
+        {
+            return [this](error_info* e, ThreadPoolData*, ThreadTask* task, ThreadPool*)
+            {
+                if (e->signal == EXCEPTION_TASK_DROPPED)
+                {
+                    std::lock_guard<std::mutex> g(mutex);
+                    dropped.push_back(task->priority);
+                }
+                else if (e->signal == EXCEPTION_TASK_COUNT_FULL)
+                {
+                    rejected++;
+                }
+            };
+        }
+
+        int submit(int id, int priority)
+        {
+            return pool.submit(
+                [this, id]()
+                {
+                    std::lock_guard<std::mutex> g(mutex);
+                    ran.push_back(id);
+                },
+                priority);
+        }
+
+        std::vector<int> finish(size_t expected)
+        {
+            gate = true;
+            while (true)
+            {
+                {
+                    std::lock_guard<std::mutex> g(mutex);
+                    if (ran.size() >= expected)
+                    {
+                        break;
+                    }
+                }
+                std::this_thread::yield();
+            }
+            pool.stop();
+            return ran;
+        }
+    };
+
+    void dropOldest(size_t agingInterval)
+    {
+        DropFixture f(REJECT_POLICY_DROP_OLDEST, agingInterval);
+        TEST_CHECK(f.submit(1, 0) == SUBMIT_ACCEPTED);
+        TEST_CHECK(f.submit(2, 1) == SUBMIT_ACCEPTED);
+        TEST_CHECK(f.submit(3, 2) == SUBMIT_ACCEPTED);
+        // 运行中的 1 个加排队的 3 个已达上限，新任务淘汰最早提交的任务，即使它优先级最高
+        TEST_CHECK(f.submit(4, 3) == SUBMIT_ACCEPTED);
+        TEST_CHECK(f.submit(5, 4) == SUBMIT_ACCEPTED);
+        TEST_CHECK((f.finish(3) == std::vector<int>{3, 4, 5}));
+        TEST_CHECK((f.dropped == std::vector<int>{0, 1}) && f.rejected.load() == 0);
+    }
+
+    void dropLowestPriority(size_t agingInterval)
+    {
+        DropFixture f(REJECT_POLICY_DROP_LOWEST_PRIORITY, agingInterval);
+        f.submit(1, 1);
+        f.submit(2, 5);
+        f.submit(3, 3);
+        // 淘汰最后才会执行的 2（优先级 5）
+        TEST_CHECK(f.submit(4, 2) == SUBMIT_ACCEPTED);
+        // 新任务不优于队列中最差的 3（优先级 3），拒绝新任务
+        TEST_CHECK(f.submit(5, 9) == EXCEPTION_TASK_COUNT_FULL);
+        TEST_CHECK(f.submit(6, 3) == EXCEPTION_TASK_COUNT_FULL);
+        TEST_CHECK((f.finish(3) == std::vector<int>{1, 4, 3}));
+        TEST_CHECK((f.dropped == std::vector<int>{5}) && f.rejected.load() == 2);
+    }
+} // namespace
+
+/**
+ * @brief 老化队列的出队顺序、老化提升与 pollMaxAbove，以及线程池的淘汰策略
+ */
+void agingQueueTest()
+{
+    using namespace std::chrono_literals;
+
+    static_assert(ConcurrentAgingQueue<int, 8>::levelOf(-3) == 0 && ConcurrentAgingQueue<int, 8>::levelOf(100) == 7);
+
+    // 不老化时严格按级出队，同级 FIFO
+    {
+        ConcurrentAgingQueue<int, 8> queue;
+        queue.push(30, 3);
+        queue.push(10, 1);
+        queue.push(31, 3);
+        queue.push(70, 100);
+        queue.push(0, -1);
+        TEST_CHECK(queue.size() == 5);
+        std::vector<int> order;
+        while (auto v = queue.tryPoll())
+        {
+            order.push_back(*v);
+        }
+        TEST_CHECK((order == std::vector<int>{0, 10, 30, 31, 70}));
+        TEST_CHECK(queue.empty() && !queue.poll(1ms).has_value());
+    }
+
+    // 老化：等待超过 级数差 × agingInterval 的元素排到新入队的高优先级元素之前
+    {
+        ConcurrentAgingQueue<int, 8> queue(10ms);
+        queue.push(5, 5);
+        queue.push(4, 4);
+        std::this_thread::sleep_for(80ms);
+        queue.push(0, 0);
+        TEST_CHECK(queue.poll(10ms) == 4);
+        TEST_CHECK(queue.poll(10ms) == 5);
+        TEST_CHECK(queue.poll(10ms) == 0);
+
+        // 新入队的元素还没有老化，高优先级的先出
+        queue.push(5, 5);
+        queue.push(0, 0);
+        TEST_CHECK(queue.tryPoll() == 0);
+        TEST_CHECK(queue.tryPoll() == 5);
+
+        // 老化间隔对已在队列中的元素同样生效
+        queue.setAgingInterval(1h);
+        queue.push(7, 7);
+        std::this_thread::sleep_for(20ms);
+        queue.push(1, 1);
+        TEST_CHECK(queue.tryPoll() == 1);
+        queue.push(2, 2);
+        queue.setAgingInterval(1ms);
+        TEST_CHECK(queue.tryPoll() == 7);
+        queue.clear();
+        TEST_CHECK(queue.empty() && !queue.tryPoll().has_value());
+    }
+
+    // pollMaxAbove 跨桶找出最大元素，只在它大于 bound 时移除
+    {
+        ConcurrentAgingQueue<int, 8> queue;
+        queue.push(3, 0);
+        queue.push(9, 6);
+        queue.push(7, 2);
+        queue.push(1, 6);
+        std::less<int> less;
+        TEST_CHECK(!queue.pollMaxAbove(9, less).has_value() && queue.size() == 4);
+        TEST_CHECK(queue.pollMaxAbove(8, less) == 9);
+        TEST_CHECK(queue.pollMaxAbove(0, less) == 7);
+        TEST_CHECK(queue.size() == 2);
+        // 按其他顺序比较：移除最小元素
+        TEST_CHECK(queue.pollMaxAbove(100, std::greater<int>()) == 1);
+        // 桶被取空后其余桶仍能正常出队
+        TEST_CHECK(queue.tryPoll() == 3 && queue.empty());
+        TEST_CHECK(!queue.pollMaxAbove(0, less).has_value());
+    }
+
+    // 线程池的淘汰策略，分别使用普通优先队列与老化队列
+    dropOldest(0);
+    dropOldest(60000);
+    dropLowestPriority(0);
+    dropLowestPriority(60000);
+}
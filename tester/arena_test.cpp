@@ -0,0 +1,191 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <tbs/concurrency/adapters.h>
+#include <tbs/concurrency/containers/PmrContainers.h>
+#include <tbs/memory/Arena.h>
+
+#include "test_check.h"
+
+namespace
+{
+    /**
+     * 统计向下游申请与归还次数的上游资源
+     */
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t liveBytes = 0;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            allocations++;
+            liveBytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            deallocations++;
+            liveBytes -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(CONST std::pmr::memory_resource& other) CONST noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    bool aligned(void* p, size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+} // namespace
+
+/**
+ * @brief Arena 的分配、换块、回收复用，以及基于它的并发容器
+ */
+void arenaTest()
+{
+    using tbs::memory::Arena;
+    constexpr size_t CHUNK = 1024;
+
+    CountingResource upstream;
+    {
+        Arena arena(CHUNK, &upstream);
+        TEST_CHECK(arena.capacity() == 0 && upstream.allocations == 0);
+
+        void* first = arena.allocate(24, 8);
+        void* wide = arena.allocate(64, 64);
+        TEST_CHECK(aligned(first, 8) && aligned(wide, 64));
+        TEST_CHECK(upstream.allocations == 1 && arena.capacity() == CHUNK);
+        TEST_CHECK(arena.usedBytes() >= 24 + 64);
+        arena.deallocate(first, 24, 8); // 空操作
+        TEST_CHECK(arena.usedBytes() >= 24 + 64);
+
+        // 当前块用尽时向上游申请新块
+        while (upstream.allocations == 1)
+        {
+            arena.allocate(100, 8);
+        }
+        TEST_CHECK(upstream.allocations == 2 && arena.capacity() == 2 * CHUNK);
+
+        // 超过块大小一半的请求单独向上游申请，不替换当前块
+        void* before = arena.allocate(8, 8);
+        void* large = arena.allocate(CHUNK * 4, 16);
+        void* after = arena.allocate(8, 8);
+        TEST_CHECK(aligned(large, 16) && upstream.allocations == 3);
+        TEST_CHECK(static_cast<char*>(after) - static_cast<char*>(before) == 8);
+        std::memset(large, 0xab, CHUNK * 4);
+
+        // reset 释放大块，保留标准块，之后的分配复用它们而不访问上游
+        arena.reset();
+        TEST_CHECK(arena.usedBytes() == 0);
+        TEST_CHECK(upstream.deallocations == 1 && arena.capacity() == 2 * CHUNK);
+        size_t allocations = upstream.allocations;
+        for (int i = 0; i < 15; i++)
+        {
+            arena.allocate(100, 8);
+        }
+        TEST_CHECK(upstream.allocations == allocations);
+        TEST_CHECK(arena.usedBytes() >= 1500);
+
+        // 备用块也用完后才重新向上游申请
+        for (int i = 0; i < 10; i++)
+        {
+            arena.allocate(100, 8);
+        }
+        TEST_CHECK(upstream.allocations == allocations + 1);
+
+        arena.release();
+        TEST_CHECK(arena.capacity() == 0 && upstream.liveBytes == 0);
+        arena.allocate(8, 8);
+        TEST_CHECK(arena.capacity() == CHUNK);
+    }
+    TEST_CHECK(upstream.liveBytes == 0 && upstream.allocations == upstream.deallocations);
+
+    // 多线程分配得到互不重叠的内存
+    {
+        Arena arena(4096);
+        constexpr int THREADS = 4;
+        constexpr int COUNT = 2000;
+        std::vector<std::vector<uint32_t*>> blocks(THREADS);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++)
+        {
+            threads.emplace_back(
+                [&, t]()
+                {
+                    for (int i = 0; i < COUNT; i++)
+                    {
+                        auto* p = static_cast<uint32_t*>(arena.allocate(4 * sizeof(uint32_t), alignof(uint32_t)));
+                        std::fill(p, p + 4, static_cast<uint32_t>(t * COUNT + i));
+                        blocks[t].push_back(p);
+                    }
+                });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        bool intact = true;
+        for (int t = 0; t < THREADS; t++)
+        {
+            for (int i = 0; i < COUNT; i++)
+            {
+                CONST uint32_t* p = blocks[t][i];
+                intact = intact && std::all_of(p, p + 4, [&](uint32_t v) { return v == static_cast<uint32_t>(t * COUNT + i); });
+            }
+        }
+        TEST_CHECK(intact);
+    }
+
+    // 基于竞技场的容器，元素存储全部来自竞技场
+    {
+        using namespace tbs::concurrency::containers;
+        Arena arena(4096, &upstream);
+
+        std::pmr::vector<std::pmr::string> words(&arena);
+        for (int i = 0; i < 100; i++)
+        {
+            words.emplace_back(std::string(40, static_cast<char>('a' + i % 26)));
+        }
+        TEST_CHECK(words.size() == 100 && std::string_view(words[27]) == std::string(40, 'b'));
+
+        pmr::ConcurrentQueue<int, SharedMutexLockAdapter> queue(&arena);
+        for (int i = 0; i < 1000; i++)
+        {
+            queue.push(i);
+        }
+        TEST_CHECK(queue.size() == 1000 && queue.poll() == 0 && queue.poll() == 1);
+
+        arena::ConcurrentUnorderedMap<int, int> map{tbs::memory::ArenaAllocator<std::pair<CONST int, int>>(arena)};
+        for (int i = 0; i < 500; i++)
+        {
+            map.insert({i, i * i});
+        }
+        TEST_CHECK(map.size() == 500 && map.at(12) == 144 && map.contains(499) && !map.contains(500));
+
+        TEST_CHECK(arena.usedBytes() > 1000 * sizeof(int));
+        size_t allocations = upstream.allocations;
+        {
+            std::pmr::vector<int> scratch(&arena);
+            scratch.resize(10);
+        }
+        TEST_CHECK(upstream.allocations - allocations <= 1);
+    }
+    TEST_CHECK(upstream.liveBytes == 0);
+}
@@ -0,0 +1,94 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <tbs/constexpr_hash.h>
+
+#include "test_check.h"
+
+namespace
+{
+    // XXH64 参考实现的输出，覆盖空串、尾部单字节 / 4 字节 / 8 字节以及 32 字节条带循环
+    static_assert(xxHash64("") == 0xEF46DB3751D8E999ull);
+    static_assert(xxHash64("a") == 0xD24EC4F1A98C6E5Bull);
+    static_assert(xxHash64("abc") == 0x44BC2CF5AD770999ull);
+    static_assert(xxHash64("hello") == 0x26C7827D889F6DA3ull);
+    static_assert(xxHash64("The quick brown fox jumps over the lazy dog") == 0x0B242D361FDA71BCull);
+    static_assert(xxHash64("abc", 1) == 0xBEA9CA8199328908ull);
+    static_assert("hello"_hash == xxHash64("hello"));
+
+    enum class Op
+    {
+        GET,
+        SET,
+        DEL
+    };
+
+    constexpr auto COMMANDS = makePerfectHashMap<std::string_view, Op>({{"get", Op::GET}, {"set", Op::SET}, {"del", Op::DEL}});
+    static_assert(COMMANDS.size() == 3 && COMMANDS.at("set") == Op::SET && !COMMANDS.contains("put"));
+
+    template <typename Key, size_t N>
+    bool buildFails(const std::pair<Key, int> (&entries)[N])
+    {
+        try
+        {
+            (void) makePerfectHashMap(entries);
+            return false;
+        }
+        catch (CONST tbs::base_error&)
+        {
+            return true;
+        }
+    }
+} // namespace
+
+/**
+ * @brief xxHash64 参考值与完美哈希表的构造、查找及失败路径
+ */
+void constexprHashTest()
+{
+    // 运行期调用与编译期结果一致
+    std::string hello = "hello";
+    TEST_CHECK(xxHash64(hello) == 0x26C7827D889F6DA3ull);
+    TEST_CHECK(xxHash64(std::string_view()) == 0xEF46DB3751D8E999ull);
+
+    // 整数键较多时必然有多个键落入同一个桶，仍须为每个键找到唯一槽位
+    std::pair<int, int> numbers[200];
+    for (int i = 0; i < 200; i++)
+    {
+        numbers[i] = {i * 7919, i};
+    }
+    auto numberMap = makePerfectHashMap(numbers);
+    bool found = true;
+    for (int i = 0; i < 200; i++)
+    {
+        found = found && numberMap.at(i * 7919) == i;
+    }
+    TEST_CHECK(found);
+    TEST_CHECK(!numberMap.contains(1) && numberMap.find(-7919) == nullptr);
+
+    std::pair<std::string_view, int> words[] = {{"alpha", 1}, {"beta", 2}, {"gamma", 3}, {"delta", 4}, {"epsilon", 5}};
+    auto wordMap = makePerfectHashMap(words);
+    TEST_CHECK(wordMap.at("delta") == 4 && wordMap.find("zeta") == nullptr);
+    bool threw = false;
+    try
+    {
+        (void) wordMap.at("zeta");
+    }
+    catch (CONST tbs::base_error&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+
+    // 重复的键在任何种子下都会冲突，构造必须失败；在常量求值中同样的 throw 会导致编译错误
+    std::pair<std::string_view, int> duplicated[] = {{"get", 1}, {"set", 2}, {"get", 3}};
+    TEST_CHECK(buildFails(duplicated));
+    std::pair<int, int> duplicatedNumbers[] = {{1, 1}, {2, 2}, {3, 3}, {2, 4}};
+    TEST_CHECK(buildFails(duplicatedNumbers));
+    std::pair<int, int> unique[] = {{1, 1}, {2, 2}, {3, 3}};
+    TEST_CHECK(!buildFails(unique));
+}
@@ -0,0 +1,198 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tbs/threads/Coroutine.h>
+#include <tbs/threads/ThreadPool.h>
+
+#include "test_check.h"
+
+namespace
+{
+    using tbs::threads::Task;
+    using tbs::threads::ThreadPool;
+
+    Task<int> value(int v)
+    {
+        co_return v;
+    }
+
+    Task<int> failing(std::string message)
+    {
+        co_await value(0);
+        throw std::runtime_error(message);
+    }
+
+    Task<void> failingVoid(ThreadPool& pool)
+    {
+        co_await pool.schedule();
+        throw std::logic_error("void task failed");
+    }
+
+    /**
+     * 在协程内部捕获被等待任务抛出的异常
+     */
+    Task<std::string> catching()
+    {
+        try
+        {
+            co_await failing("inner");
+        }
+        catch (CONST std::runtime_error& e)
+        {
+            co_return std::string("caught ") + e.what();
+        }
+        co_return "not thrown";
+    }
+
+    /**
+     * 不捕获，异常沿等待链一直传到 syncWait
+     */
+    Task<int> forwarding(int depth)
+    {
+        if (depth == 0)
+        {
+            co_return co_await failing("deep");
+        }
+        co_return co_await forwarding(depth - 1) + 1;
+    }
+
+    Task<std::thread::id> resumedOn(ThreadPool& pool)
+    {
+        co_await pool.schedule();
+        co_return std::this_thread::get_id();
+    }
+
+    /**
+     * 切换到线程池后等待 gate 打开再返回 v；gate 为空时立即返回
+     */
+    Task<int> gated(ThreadPool& pool, int v, std::atomic_bool* gate, std::atomic_int& finished)
+    {
+        co_await pool.schedule();
+        while (gate != nullptr && !gate->load())
+        {
+            std::this_thread::yield();
+        }
+        finished++;
+        co_return v;
+    }
+} // namespace
+
+/**
+ * @brief 协程任务的异常传播、whenAny 与在线程池上恢复
+ */
+void coroutineTest()
+{
+    using namespace tbs::threads;
+
+    // 异常穿过 co_await：可以在外层协程中捕获，也可以沿整条等待链传到 syncWait
+    TEST_CHECK(syncWait(catching()) == "caught inner");
+    std::string message;
+    try
+    {
+        syncWait(forwarding(50));
+    }
+    catch (CONST std::runtime_error& e)
+    {
+        message = e.what();
+    }
+    TEST_CHECK(message == "deep");
+
+    // 只有一个工作线程时，恢复协程的线程必然就是它
+    {
+        ThreadPool pool("co-single", 1, 16, 1, 60000);
+        pool.start();
+        std::promise<std::thread::id> worker;
+        pool.submit([&worker]() { worker.set_value(std::this_thread::get_id()); });
+        std::thread::id workerId = worker.get_future().get();
+        std::thread::id resumed = syncWait(resumedOn(pool));
+        TEST_CHECK(workerId != std::this_thread::get_id());
+        TEST_CHECK(resumed == workerId);
+        pool.stop();
+    }
+
+    ThreadPool pool("co-test", 3, 64, 3, 60000);
+    pool.start();
+
+    // 在工作线程上抛出的异常同样传回等待者
+    bool logicError = false;
+    try
+    {
+        syncWait(failingVoid(pool));
+    }
+    catch (CONST std::logic_error&)
+    {
+        logicError = true;
+    }
+    TEST_CHECK(logicError);
+
+    // whenAny 在第一个任务完成时就返回，不等待被阻塞的其他任务
+    {
+        std::atomic_bool gate{false};
+        std::atomic_int finished{0};
+        std::vector<Task<int>> tasks;
+        tasks.push_back(gated(pool, 10, &gate, finished));
+        tasks.push_back(gated(pool, 11, nullptr, finished));
+        tasks.push_back(gated(pool, 12, &gate, finished));
+        auto [index, result] = syncWait(whenAny(std::move(tasks)));
+        TEST_CHECK(index == 1 && result == 11);
+        TEST_CHECK(finished.load() == 1);
+        gate = true;
+        while (finished.load() != 3)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // 同步完成的任务在启动时就胜出
+    {
+        std::atomic_bool gate{false};
+        std::atomic_int finished{0};
+        std::vector<Task<int>> tasks;
+        tasks.push_back(gated(pool, 20, &gate, finished));
+        tasks.push_back(value(21));
+        auto [index, result] = syncWait(whenAny(std::move(tasks)));
+        TEST_CHECK(index == 1 && result == 21);
+        gate = true;
+        while (finished.load() != 1)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // 首个完成的任务抛出异常时由 whenAny 重新抛出
+    {
+        std::vector<Task<int>> tasks;
+        tasks.push_back(failing("first"));
+        tasks.push_back(value(1));
+        std::string first;
+        try
+        {
+            syncWait(whenAny(std::move(tasks)));
+        }
+        catch (CONST std::runtime_error& e)
+        {
+            first = e.what();
+        }
+        TEST_CHECK(first == "first");
+    }
+
+    bool empty = false;
+    try
+    {
+        syncWait(whenAny(std::vector<Task<int>>{}));
+    }
+    catch (CONST std::invalid_argument&)
+    {
+        empty = true;
+    }
+    TEST_CHECK(empty);
+
+    pool.stop();
+}
@@ -0,0 +1,157 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <tbs/threads/CpuTopology.h>
+#include <tbs/threads/ThreadPool.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "test_check.h"
+
+namespace
+{
+    using namespace tbs::threads;
+
+    /**
+     * 当前线程的 CPU 亲和性，非 Linux 平台上为空
+     */
+    std::vector<int> currentAffinity()
+    {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            {
+                if (CPU_ISSET(cpu, &set))
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        return cpus;
+    }
+
+    /**
+     * 在线程池上运行一个任务，返回执行它的工作线程的亲和性
+     */
+    std::vector<int> workerAffinity(ThreadPool& pool, int node = -1)
+    {
+        std::promise<std::vector<int>> result;
+        auto task = [&result]() { result.set_value(currentAffinity()); };
+        if (node < 0)
+        {
+            pool.submit(task);
+        }
+        else
+        {
+            pool.submitToNode(node, task);
+        }
+        return result.get_future().get();
+    }
+} // namespace
+
+/**
+ * @brief cpulist 解析、系统拓扑的一致性，以及线程池各放置策略下工作线程的绑定
+ */
+void cpuTopologyTest()
+{
+    TEST_CHECK((CpuTopology::parseCpuList("0-3,8,10-11") == std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    TEST_CHECK((CpuTopology::parseCpuList(" 5 , 1-2,2,x,3-y,, 0\n") == std::vector<int>{0, 1, 2, 5}));
+    TEST_CHECK(CpuTopology::parseCpuList("").empty());
+
+    // 节点按编号升序，节点内 CPU 升序、互不重叠，并且都在进程的亲和性之内
+    CONST CpuTopology& topology = CpuTopology::system();
+    std::vector<int> allowed = currentAffinity();
+    TEST_CHECK(!topology.nodes().empty());
+    bool consistent = true;
+    std::vector<int> all;
+    for (size_t k = 0; k < topology.nodes().size(); k++)
+    {
+        CONST NumaNode& node = topology.nodes()[k];
+        consistent = consistent && !node.cpus.empty() && std::is_sorted(node.cpus.begin(), node.cpus.end());
+        consistent = consistent && (k == 0 || topology.nodes()[k - 1].id < node.id);
+        for (int cpu : node.cpus)
+        {
+            consistent = consistent && topology.nodeOf(cpu) == node.id;
+            consistent = consistent && (allowed.empty() || std::binary_search(allowed.begin(), allowed.end(), cpu));
+            all.push_back(cpu);
+        }
+    }
+    std::sort(all.begin(), all.end());
+    consistent = consistent && std::adjacent_find(all.begin(), all.end()) == all.end();
+    TEST_CHECK(consistent);
+    TEST_CHECK(topology.nodeOf(-1) == -1);
+
+    CONST NumaNode& first = topology.nodes().front();
+    int firstCpu = first.cpus.front();
+
+#ifdef __linux__
+    // 绑定当前线程：在新线程上进行，不影响主线程
+    std::thread(
+        [&]()
+        {
+            TEST_CHECK(CpuTopology::pinCurrentThread({firstCpu}));
+            TEST_CHECK((currentAffinity() == std::vector<int>{firstCpu}));
+            TEST_CHECK(!CpuTopology::pinCurrentThread({-1, CPU_SETSIZE}));
+            TEST_CHECK((currentAffinity() == std::vector<int>{firstCpu}));
+        })
+        .join();
+
+    // PLACEMENT_CPU_SET：每个工作线程绑定到整个 cpuSet
+    {
+        ThreadPool pool("cpu-set", 2, 16, 2, 60000);
+        pool.getConfig().placement = PLACEMENT_CPU_SET;
+        pool.getConfig().cpuSet = {firstCpu};
+        pool.start();
+        TEST_CHECK((workerAffinity(pool) == std::vector<int>{firstCpu}));
+        pool.stop();
+    }
+
+    // PLACEMENT_PACK：每个工作线程只绑定一个 CPU，submitToNode 交给该节点上的线程
+    {
+        ThreadPool pool("pack", 2, 16, 2, 60000);
+        pool.getConfig().placement = PLACEMENT_PACK;
+        pool.start();
+        bool pinned = true;
+        for (int k = 0; k < 8; k++)
+        {
+            std::vector<int> cpus = workerAffinity(pool);
+            pinned = pinned && cpus.size() == 1 && topology.nodeOf(cpus.front()) >= 0;
+        }
+        TEST_CHECK(pinned);
+        std::vector<int> onNode = workerAffinity(pool, first.id);
+        TEST_CHECK(onNode.size() == 1 && topology.nodeOf(onNode.front()) == first.id);
+        pool.stop();
+    }
+
+    // PLACEMENT_SPREAD：工作线程绑定到所在节点的全部 CPU
+    {
+        ThreadPool pool("spread", 2, 16, 2, 60000);
+        pool.getConfig().placement = PLACEMENT_SPREAD;
+        pool.start();
+        TEST_CHECK(workerAffinity(pool, first.id) == first.cpus);
+        pool.stop();
+    }
+
+    // cpuSet 与拓扑没有交集时不绑定，工作线程保留进程的亲和性
+    {
+        ThreadPool pool("unpinned", 1, 16, 1, 60000);
+        pool.getConfig().placement = PLACEMENT_PACK;
+        pool.getConfig().cpuSet = {CPU_SETSIZE + 1};
+        pool.start();
+        TEST_CHECK(workerAffinity(pool) == allowed);
+        pool.stop();
+    }
+#endif
+}
@@ -0,0 +1,109 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <string>
+#include <utility>
+
+#include <tbs/FastPimpl.h>
+
+#include "test_check.h"
+
+namespace
+{
+    struct Counters
+    {
+        int constructed = 0;
+        int copied = 0;
+        int moved = 0;
+        int destroyed = 0;
+    };
+
+    Counters counters;
+
+    struct alignas(32) WidgetImpl
+    {
+        std::string name;
+        int value = 0;
+
+        WidgetImpl(std::string n, int v) : name(std::move(n)), value(v)
+        {
+            counters.constructed++;
+        }
+
+        WidgetImpl(const WidgetImpl& o) : name(o.name), value(o.value)
+        {
+            counters.copied++;
+        }
+
+        WidgetImpl(WidgetImpl&& o) noexcept : name(std::move(o.name)), value(o.value)
+        {
+            counters.moved++;
+        }
+
+        WidgetImpl& operator=(const WidgetImpl&) = default;
+        WidgetImpl& operator=(WidgetImpl&&) noexcept = default;
+
+        ~WidgetImpl()
+        {
+            counters.destroyed++;
+        }
+    };
+
+    // 缓冲区恰好等于实现类的大小与对齐，是 validate 允许的边界
+    class Widget : public FastPimpl<WidgetImpl, sizeof(WidgetImpl), alignof(WidgetImpl)>
+    {
+    public:
+        Widget(std::string name, int value) : FastPimpl(std::move(name), value)
+        {
+        }
+
+        CONST std::string& name() CONST
+        {
+            return getImpl().name;
+        }
+
+        int value() CONST
+        {
+            return getImpl().value;
+        }
+    };
+
+    static_assert(alignof(Widget) >= alignof(WidgetImpl));
+    static_assert(sizeof(Widget) >= sizeof(WidgetImpl));
+    static_assert(std::is_nothrow_move_constructible_v<Widget>);
+} // namespace
+
+/**
+ * @brief FastPimpl 的就地构造、拷贝、移动与析构
+ */
+void fastPimplTest()
+{
+    counters = Counters{};
+    {
+        Widget a("alpha", 1);
+        TEST_CHECK(a.name() == "alpha" && a.value() == 1);
+        TEST_CHECK(counters.constructed == 1);
+
+        Widget b(a);
+        TEST_CHECK(b.name() == "alpha" && b.value() == 1);
+        TEST_CHECK(counters.copied == 1);
+
+        Widget c(std::move(b));
+        TEST_CHECK(c.name() == "alpha" && c.value() == 1);
+        TEST_CHECK(counters.moved == 1);
+
+        Widget d("delta", 4);
+        d = a;
+        TEST_CHECK(d.name() == "alpha" && d.value() == 1);
+        Widget e("echo", 5);
+        e = std::move(d);
+        TEST_CHECK(e.name() == "alpha");
+        e = e;
+        TEST_CHECK(e.name() == "alpha");
+
+        // 赋值复用已有对象，不产生新的实现类对象
+        TEST_CHECK(counters.constructed == 3 && counters.copied == 1 && counters.moved == 1);
+        TEST_CHECK(counters.destroyed == 0);
+    }
+    TEST_CHECK(counters.destroyed == 5);
+}
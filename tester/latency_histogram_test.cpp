@@ -0,0 +1,98 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <cstdint>
+#include <random>
+
+#include <tbs/threads/ThreadPoolMetrics.h>
+
+#include "test_check.h"
+
+namespace
+{
+    using tbs::threads::LatencyHistogram;
+
+    // 37 个 2 的幂区间（[0, 32) 线性部分占两个）每个 16 个子桶
+    static_assert(LatencyHistogram::BUCKETS == 592);
+    static_assert(LatencyHistogram::indexOf(0) == 0 && LatencyHistogram::indexOf(31) == 31);
+    static_assert(LatencyHistogram::indexOf(32) == 32 && LatencyHistogram::indexOf(33) == 32 && LatencyHistogram::indexOf(34) == 33);
+    static_assert(LatencyHistogram::upperBound(LatencyHistogram::BUCKETS - 1) == (1ull << 40) - 1);
+
+    /**
+     * 值落在所在桶的上下界之间，且桶宽不超过下界的 1/16
+     */
+    bool fits(uint64_t v)
+    {
+        size_t i = LatencyHistogram::indexOf(v);
+        uint64_t lo = LatencyHistogram::lowerBound(i);
+        uint64_t hi = LatencyHistogram::upperBound(i);
+        bool inside = i < LatencyHistogram::BUCKETS && lo <= v && v <= hi;
+        bool precise = lo < 2 * LatencyHistogram::SUB_COUNT ? lo == hi : (hi - lo + 1) * LatencyHistogram::SUB_COUNT <= lo;
+        return inside && precise;
+    }
+} // namespace
+
+/**
+ * @brief 延迟直方图的桶下标与上下界换算、记录与分位数
+ */
+void latencyHistogramTest()
+{
+    // 桶首尾相接地覆盖 [0, 2^40)，每个桶的下界映射回自身
+    bool contiguous = LatencyHistogram::lowerBound(0) == 0;
+    for (size_t i = 0; i < LatencyHistogram::BUCKETS; i++)
+    {
+        contiguous = contiguous && LatencyHistogram::indexOf(LatencyHistogram::lowerBound(i)) == i &&
+                     LatencyHistogram::indexOf(LatencyHistogram::upperBound(i)) == i &&
+                     LatencyHistogram::lowerBound(i) <= LatencyHistogram::upperBound(i);
+        if (i + 1 < LatencyHistogram::BUCKETS)
+        {
+            contiguous = contiguous && LatencyHistogram::upperBound(i) + 1 == LatencyHistogram::lowerBound(i + 1);
+        }
+    }
+    TEST_CHECK(contiguous);
+
+    bool exact = true;
+    for (uint64_t v = 0; v < 1 << 16; v++)
+    {
+        exact = exact && fits(v);
+    }
+    for (int e = 5; e < LatencyHistogram::MAX_EXPONENT; e++)
+    {
+        uint64_t p = 1ull << e;
+        exact = exact && fits(p - 1) && fits(p) && fits(p + 1) && LatencyHistogram::lowerBound(LatencyHistogram::indexOf(p)) == p;
+    }
+    std::mt19937_64 rng(42);
+    for (int k = 0; k < 100000; k++)
+    {
+        exact = exact && fits(rng() >> (rng() % 40 + 24));
+    }
+    TEST_CHECK(exact);
+
+    // 超出范围的值计入最后一个桶
+    TEST_CHECK(LatencyHistogram::indexOf(1ull << 40) == LatencyHistogram::BUCKETS - 1);
+    TEST_CHECK(LatencyHistogram::indexOf(UINT64_MAX) == LatencyHistogram::BUCKETS - 1);
+
+    // 记录与分位数：1..1000 各一次
+    LatencyHistogram histogram;
+    TEST_CHECK(histogram.snapshot().count() == 0 && histogram.snapshot().percentile(50) == 0);
+    for (uint64_t v = 1; v <= 1000; v++)
+    {
+        histogram.record(v);
+    }
+    auto snapshot = histogram.snapshot();
+    TEST_CHECK(snapshot.count() == 1000 && snapshot.mean() == 500.5);
+    TEST_CHECK(snapshot.counts().size() == LatencyHistogram::BUCKETS);
+    for (double p : {1.0, 10.0, 50.0, 90.0, 99.0, 100.0})
+    {
+        auto expected = static_cast<uint64_t>(p * 10);
+        uint64_t got = snapshot.percentile(p);
+        TEST_CHECK(got >= expected && (got - expected) * LatencyHistogram::SUB_COUNT <= expected);
+    }
+    TEST_CHECK(snapshot.percentile(0) == 1 && snapshot.max() == LatencyHistogram::upperBound(LatencyHistogram::indexOf(1000)));
+
+    LatencyHistogram slow;
+    slow.record(5'000'000);
+    snapshot.merge(slow.snapshot());
+    TEST_CHECK(snapshot.count() == 1001 && snapshot.percentile(99) < 1000);
+    TEST_CHECK(snapshot.max() >= 5'000'000 && snapshot.max() <= 5'000'000 + 5'000'000 / LatencyHistogram::SUB_COUNT);
+}
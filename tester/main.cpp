@@ -20,8 +20,44 @@ auto test()
 }
 #include <tbs/log/log.hpp>
 
-int main()
+#include "test_check.h"
+
+void matchBatchBenchmark();
+void numericTest();
+void switchMatchTest();
+void fastPimplTest();
+void optionTest();
+void arenaTest();
+void constexprHashTest();
+void coroutineTest();
+void taskGraphTest();
+void latencyHistogramTest();
+void agingQueueTest();
+void cpuTopologyTest();
+
+int main(int argc, char** argv)
 {
+    if (argc > 1 && std::string(argv[1]) == "match-batch")
+    {
+        matchBatchBenchmark();
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "test")
+    {
+        numericTest();
+        switchMatchTest();
+        fastPimplTest();
+        optionTest();
+        arenaTest();
+        constexprHashTest();
+        coroutineTest();
+        taskGraphTest();
+        latencyHistogramTest();
+        agingQueueTest();
+        cpuTopologyTest();
+        std::cout << (testFailures() == 0 ? "all tests passed" : "tests failed") << std::endl;
+        return testFailures() == 0 ? 0 : 1;
+    }
     std::cout << LOG_FORMAT("hello world{}", 1) << std::endl;
     return 0;
 }
@@ -0,0 +1,74 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <tbs/match/match_batch.h>
+
+/**
+ * @brief matchBatch 与逐值标量循环的对比基准：把一组时间戳按区间分为 4 类
+ */
+void matchBatchBenchmark()
+{
+    constexpr size_t COUNT = 1 << 22;
+    constexpr int ROUNDS = 20;
+    std::mt19937_64 rng(42);
+    std::vector<int64_t> stamps(COUNT);
+    for (auto& s : stamps)
+    {
+        s = static_cast<int64_t>(rng() % 4000000);
+    }
+    std::span<const int64_t> values(stamps);
+    std::vector<uint8_t> scalarOut(COUNT), batchOut(COUNT);
+
+    auto f = [](const auto&, const auto&) { return 0; };
+    auto recent = make_greater_than_or_equal_matcher(int64_t(3000000), f);
+    auto today = make_greater_than_or_equal_matcher(int64_t(2000000), f);
+    auto week = make_greater_than_or_equal_matcher(int64_t(1000000), f);
+    auto old = make_less_than_matcher(int64_t(1000000), f);
+
+    auto measure = [&](auto&& body)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (int r = 0; r < ROUNDS; r++)
+        {
+            body();
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+        return static_cast<double>(ns) / (static_cast<double>(COUNT) * ROUNDS);
+    };
+
+    double scalarNs = measure(
+        [&]()
+        {
+            for (size_t i = 0; i < COUNT; i++)
+            {
+                int64_t v = stamps[i];
+                scalarOut[i] = recent.test(v) ? 0 : today.test(v) ? 1 : week.test(v) ? 2 : old.test(v) ? 3 : 4;
+            }
+        });
+    double batchNs = measure([&]() { matchBatch(values, recent, today, week, old, batchOut); });
+
+    std::cout << "scalar loop: " << scalarNs << " ns/value" << std::endl;
+    std::cout << "matchBatch:  " << batchNs << " ns/value" << std::endl;
+    std::cout << "speedup:     " << scalarNs / batchNs << "x" << (scalarOut == batchOut ? "" : " (MISMATCH)") << std::endl;
+
+    // 边界类型与值类型不同：int32 值对 double 边界与超出 int32 范围的 int64 边界，结果须与标量路径一致
+    std::vector<int32_t> small(4096);
+    for (auto& v : small)
+    {
+        v = static_cast<int32_t>(rng() % 17) - 8;
+    }
+    std::span<const int32_t> smallValues(small);
+    auto huge = make_greater_than_matcher(int64_t(1) << 32 | 1, f);
+    auto fraction = make_less_than_matcher(2.5, f);
+    auto any = make_any_matcher(f);
+    std::vector<uint8_t> mixedScalar(small.size()), mixedBatch(small.size());
+    matchBatchScalar(smallValues, huge, fraction, any, mixedScalar);
+    matchBatch(smallValues, huge, fraction, any, mixedBatch);
+    std::cout << "mixed types: " << (mixedScalar == mixedBatch ? "ok" : "MISMATCH") << std::endl;
+}
@@ -0,0 +1,42 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <cstdint>
+
+#include <tbs/strings/Numeric.h>
+
+#include "test_check.h"
+
+/**
+ * @brief parseInt / parseFloat 的符号、进制与溢出处理
+ */
+void numericTest()
+{
+    TEST_CHECK(*parseInt<int>("123") == 123);
+    TEST_CHECK(*parseInt<int>("+123") == 123);
+    TEST_CHECK(*parseInt<int>("-123") == -123);
+    TEST_CHECK(*parseInt<int>("ff", 16) == 255);
+    TEST_CHECK(*parseInt<int>("+ff", 16) == 255);
+    TEST_CHECK(*parseInt<int>("-ff", 16) == -255);
+    TEST_CHECK(*parseInt<int64_t>("-9223372036854775808") == INT64_MIN);
+    TEST_CHECK(*parseInt<uint64_t>("+18446744073709551615", 10) == UINT64_MAX);
+
+    // 只允许一个符号
+    TEST_CHECK(parseInt<int>("+-ff", 16).isNull());
+    TEST_CHECK(parseInt<int>("+-5").isNull());
+    TEST_CHECK(parseInt<int>("-+5").isNull());
+    TEST_CHECK(parseInt<int>("--5").isNull());
+    TEST_CHECK(parseInt<int>("++5").isNull());
+    TEST_CHECK(parseInt<int64_t>("+-12345678901234567890", 10).isNull());
+
+    TEST_CHECK(parseInt<int>("").isNull());
+    TEST_CHECK(parseInt<int>("+").isNull());
+    TEST_CHECK(parseInt<unsigned>("-1").isNull());
+    TEST_CHECK(parseInt<int8_t>("128").isNull());
+    TEST_CHECK(*parseInt<int8_t>("-128") == -128);
+    TEST_CHECK(parseInt<int>("12a").isNull());
+
+    TEST_CHECK(*parseFloat<double>("+1.5") == 1.5);
+    TEST_CHECK(*parseFloat<double>("-1.5") == -1.5);
+    TEST_CHECK(parseFloat<double>("+-1.5").isNull());
+}
@@ -0,0 +1,104 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <tbs/Option.h>
+
+#include "test_check.h"
+
+namespace
+{
+    struct Point
+    {
+        int x = 0;
+        int y = 0;
+    };
+
+    Option<int> half(int v)
+    {
+        return v % 2 == 0 ? Option<int>(v / 2) : Option<int>();
+    }
+} // namespace
+
+/**
+ * @brief Option 的组合子在空与非空时的行为，以及引用 Option
+ */
+void optionTest()
+{
+    Option<int> some(4);
+    Option<int> none;
+
+    // map
+    TEST_CHECK(*some.map([](int v) { return v + 1; }) == 5);
+    TEST_CHECK(none.map([](int v) { return v + 1; }).isNull());
+    auto text = some.map([](int v) { return std::to_string(v); });
+    static_assert(std::is_same_v<decltype(text), Option<std::string>>);
+    TEST_CHECK(*text == "4");
+
+    // 函数返回左值引用时得到 Option<U&>，指向原对象
+    Option<Point> point(Point{1, 2});
+    auto x = point.map([](Point& p) -> int& { return p.x; });
+    static_assert(std::is_same_v<decltype(x), Option<int&>>);
+    *x = 10;
+    TEST_CHECK(point->x == 10);
+    Option<Point> noPoint;
+    TEST_CHECK(noPoint.map([](Point& p) -> int& { return p.x; }).isNull());
+
+    // 右值上的 map 移动内部值
+    auto moved = Option<std::unique_ptr<int>>(std::make_unique<int>(7)).map([](std::unique_ptr<int>&& p) { return std::move(p); });
+    TEST_CHECK(moved && **moved == 7);
+
+    // and_then
+    TEST_CHECK(*some.and_then(half) == 2);
+    TEST_CHECK(Option<int>(3).and_then(half).isNull());
+    TEST_CHECK(none.and_then(half).isNull());
+    TEST_CHECK(*some.and_then(half).and_then(half) == 1);
+
+    // or_else
+    TEST_CHECK(*some.or_else([]() { return Option<int>(9); }) == 4);
+    TEST_CHECK(*none.or_else([]() { return Option<int>(9); }) == 9);
+    TEST_CHECK(Option<std::string>().or_else([]() { return Option<std::string>(); }).isNull());
+    TEST_CHECK(*Option<std::string>(std::string("a")).or_else([]() { return Option<std::string>(std::string("b")); }) == "a");
+
+    // value_or
+    TEST_CHECK(some.value_or(0) == 4);
+    TEST_CHECK(none.value_or(0) == 0);
+
+    // transform 在左值上就地修改并返回自身
+    Option<std::vector<int>> list(std::vector<int>{1});
+    auto& same = list.transform([](std::vector<int>& v) { v.push_back(2); });
+    TEST_CHECK(&same == &list && list->size() == 2);
+    none.transform([](int& v) { v = 1; });
+    TEST_CHECK(none.isNull());
+
+    // transform 在右值上按值返回，绑定到引用时不会悬垂
+    static_assert(std::is_same_v<decltype(Option<std::string>().transform([](std::string&) {})), Option<std::string>>);
+    auto&& grown = Option<std::string>(std::string("ab")).transform([](std::string& s) { s += "c"; });
+    TEST_CHECK(*grown == "abc");
+    TEST_CHECK(Option<std::string>().transform([](std::string& s) { s += "c"; }).isNull());
+
+    // 引用 Option
+    int target = 1;
+    auto ref = REF_OPTION(target);
+    static_assert(std::is_same_v<decltype(ref), Option<int&>>);
+    *ref = 2;
+    TEST_CHECK(target == 2);
+    ref.transform([](int& v) { v *= 10; });
+    TEST_CHECK(target == 20);
+    TEST_CHECK(*ref.map([](int& v) { return v + 1; }) == 21);
+    TEST_CHECK(*ref.and_then(half) == 10);
+    int fallbackValue = 0;
+    TEST_CHECK(&ref.value_or(fallbackValue) == &target);
+    Option<int&> emptyRef;
+    TEST_CHECK(&emptyRef.value_or(fallbackValue) == &fallbackValue);
+    TEST_CHECK(emptyRef.map([](int& v) { return v; }).isNull());
+    TEST_CHECK(&*emptyRef.or_else([&]() { return REF_OPTION(target); }) == &target);
+    TEST_CHECK(emptyRef == NONE_OPTION);
+    TEST_CHECK(ref != NONE_OPTION);
+    TEST_CHECK(ref == Option<int>(20));
+}
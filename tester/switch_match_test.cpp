@@ -0,0 +1,139 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <tbs/match/matchers.h>
+#include <tbs/match/switch_match.h>
+
+#include "test_check.h"
+
+namespace
+{
+    enum class Color : uint8_t
+    {
+        RED = 1,
+        GREEN = 2,
+        BLUE = 3,
+    };
+
+    auto idOf(int id)
+    {
+        return [id](const auto&, const auto&) { return id; };
+    }
+
+    auto fallback()
+    {
+        return []() { return -1; };
+    }
+
+    int dense(int v)
+    {
+        return switchMatch(v, make_case_matcher<1>(idOf(0)), make_case_matcher<2>(idOf(1)), make_case_matcher<4>(idOf(2)), fallback());
+    }
+
+    int sparse(int64_t v)
+    {
+        return switchMatch(v,
+                           make_case_matcher<-1000000>(idOf(0)),
+                           make_case_matcher<7>(idOf(1)),
+                           make_case_matcher<INT64_MAX>(idOf(2)),
+                           fallback());
+    }
+
+    int color(Color c)
+    {
+        return switchMatch(c, make_case_matcher<Color::RED>(idOf(0)), make_case_matcher<Color::BLUE>(idOf(1)), fallback());
+    }
+
+    int character(char c)
+    {
+        return switchMatch(c, make_case_matcher<'a'>(idOf(0)), make_case_matcher<'b'>(idOf(1)), make_case_matcher<'z'>(idOf(2)), fallback());
+    }
+
+    int charKeys(int v)
+    {
+        return switchMatch(v, make_case_matcher<'0'>(idOf(0)), make_case_matcher<'9'>(idOf(1)), fallback());
+    }
+
+    int wide(char32_t c)
+    {
+        return switchMatch(c, make_case_matcher<U'中'>(idOf(0)), make_case_matcher<U'A'>(idOf(1)), fallback());
+    }
+
+    int flag(bool b)
+    {
+        return switchMatch(b, make_case_matcher<true>(idOf(0)), fallback());
+    }
+
+    int word(std::string_view s)
+    {
+        return switchMatch(s,
+                           make_case_matcher<make_ConstexprValue("get")>(idOf(0)),
+                           make_case_matcher<make_ConstexprValue("put")>(idOf(1)),
+                           make_case_matcher<make_ConstexprValue("post")>(idOf(2)),
+                           make_case_matcher<make_ConstexprValue("delete")>(idOf(3)),
+                           fallback());
+    }
+} // namespace
+
+/**
+ * @brief switchMatch 的跳转表、二分查找、完美哈希与逐个测试四种分派
+ */
+void switchMatchTest()
+{
+    using namespace switch_match_detail;
+    auto f = idOf(0);
+    using F = decltype(f);
+    static_assert(IntegralDispatch<int, CaseMatcher<1, F>, CaseMatcher<2, F>, CaseMatcher<4, F>>::DENSE);
+    static_assert(!IntegralDispatch<int64_t, CaseMatcher<-1000000, F>, CaseMatcher<7, F>, CaseMatcher<INT64_MAX, F>>::DENSE);
+
+    TEST_CHECK(dense(1) == 0);
+    TEST_CHECK(dense(2) == 1);
+    TEST_CHECK(dense(4) == 2);
+    TEST_CHECK(dense(3) == -1);
+    TEST_CHECK(dense(0) == -1);
+    TEST_CHECK(dense(-100) == -1);
+
+    TEST_CHECK(sparse(-1000000) == 0);
+    TEST_CHECK(sparse(7) == 1);
+    TEST_CHECK(sparse(INT64_MAX) == 2);
+    TEST_CHECK(sparse(8) == -1);
+    TEST_CHECK(sparse(INT64_MIN) == -1);
+
+    TEST_CHECK(color(Color::RED) == 0);
+    TEST_CHECK(color(Color::BLUE) == 1);
+    TEST_CHECK(color(Color::GREEN) == -1);
+
+    TEST_CHECK(character('a') == 0);
+    TEST_CHECK(character('b') == 1);
+    TEST_CHECK(character('z') == 2);
+    TEST_CHECK(character('c') == -1);
+    TEST_CHECK(character('\xff') == -1);
+    TEST_CHECK(charKeys('0') == 0);
+    TEST_CHECK(charKeys('9') == 1);
+    TEST_CHECK(charKeys(0) == -1);
+    TEST_CHECK(wide(U'中') == 0);
+    TEST_CHECK(wide(U'A') == 1);
+    TEST_CHECK(wide(U'B') == -1);
+    TEST_CHECK(flag(true) == 0);
+    TEST_CHECK(flag(false) == -1);
+
+    TEST_CHECK(word("get") == 0);
+    TEST_CHECK(word("put") == 1);
+    TEST_CHECK(word("post") == 2);
+    TEST_CHECK(word("delete") == 3);
+    TEST_CHECK(word("gets") == -1);
+    TEST_CHECK(word("") == -1);
+    TEST_CHECK(word(std::string("po") + "st") == 2);
+
+    // 含运行期键的匹配器时逐个测试，按顺序取第一个命中的分支
+    int limit = 10;
+    auto linear = [&](int v)
+    { return switchMatch(v, make_case_matcher<5>(idOf(0)), make_less_than_matcher(limit, idOf(1)), fallback()); };
+    TEST_CHECK(linear(5) == 0);
+    TEST_CHECK(linear(3) == 1);
+    TEST_CHECK(linear(20) == -1);
+}
@@ -0,0 +1,172 @@
+//
+// Created by abstergo on 26-10-18.
+//
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <tbs/threads/TaskGraph.h>
+
+#include "test_check.h"
+
+namespace
+{
+    /**
+     * 记录每个节点完成的先后顺序
+     */
+    struct OrderRecorder
+    {
+        std::atomic_int clock{0};
+        std::vector<std::atomic_int> stamps;
+        std::vector<std::atomic_int> runs;
+
+        explicit OrderRecorder(size_t n) : stamps(n), runs(n)
+        {
+        }
+
+        std::function<void()> node(size_t i)
+        {
+            return [this, i]()
+            {
+                runs[i]++;
+                stamps[i] = ++clock;
+            };
+        }
+
+        bool respects(CONST std::vector<std::pair<size_t, size_t>>& edges) CONST
+        {
+            for (auto& [from, to] : edges)
+            {
+                if (stamps[from].load() >= stamps[to].load())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool ranEach(int times) CONST
+        {
+            for (auto& r : runs)
+            {
+                if (r.load() != times)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    template <typename E>
+    bool throws(CONST std::function<void()>& f)
+    {
+        try
+        {
+            f();
+        }
+        catch (CONST E&)
+        {
+            return true;
+        }
+        return false;
+    }
+} // namespace
+
+/**
+ * @brief 任务图的依赖顺序、重复运行、环检测与异常传播
+ */
+void taskGraphTest()
+{
+    using tbs::threads::TaskGraph;
+    using tbs::threads::ThreadPool;
+
+    ThreadPool pool("graph-test", 4, 256, 4, 60000);
+    pool.start();
+
+    // 菱形加一层扇出扇入：0 -> {1, 2} -> 3 -> {4..11} -> 12
+    constexpr size_t NODES = 13;
+    OrderRecorder recorder(NODES);
+    TaskGraph graph(pool);
+    for (size_t i = 0; i < NODES; i++)
+    {
+        TEST_CHECK(graph.addNode(recorder.node(i)) == i);
+    }
+    std::vector<std::pair<size_t, size_t>> edges{{0, 1}, {0, 2}, {1, 3}, {2, 3}};
+    for (size_t i = 4; i < 12; i++)
+    {
+        edges.emplace_back(3, i);
+        edges.emplace_back(i, 12);
+    }
+    for (auto& [from, to] : edges)
+    {
+        graph.addEdge(from, to);
+    }
+    TEST_CHECK(graph.size() == NODES);
+
+    graph.run();
+    TEST_CHECK(recorder.ranEach(1));
+    TEST_CHECK(recorder.respects(edges));
+
+    // 重复运行：每次每个节点恰好执行一次，顺序仍满足依赖
+    bool ordered = true;
+    for (int round = 2; round <= 20; round++)
+    {
+        graph.run();
+        ordered = ordered && recorder.respects(edges);
+    }
+    TEST_CHECK(ordered);
+    TEST_CHECK(recorder.ranEach(20));
+
+    // 修改后的图重新检查并运行
+    std::atomic_int tail{0};
+    size_t last = graph.addNode([&]() { tail = recorder.stamps[12].load(); });
+    graph.addEdge(12, last);
+    graph.run();
+    TEST_CHECK(tail.load() == recorder.stamps[12].load() && recorder.ranEach(21));
+
+    // 环：运行时抛出 std::invalid_argument，且没有节点被执行
+    {
+        std::atomic_int ran{0};
+        TaskGraph cyclic(pool);
+        size_t a = cyclic.addNode([&]() { ran++; });
+        size_t b = cyclic.addNode([&]() { ran++; });
+        size_t c = cyclic.addNode([&]() { ran++; });
+        size_t free = cyclic.addNode([&]() { ran++; });
+        cyclic.addEdge(a, b);
+        cyclic.addEdge(b, c);
+        cyclic.addEdge(c, a);
+        (void) free;
+        TEST_CHECK(throws<std::invalid_argument>([&]() { cyclic.run(); }));
+        TEST_CHECK(ran.load() == 0);
+    }
+
+    // 运行过的图加边成环后同样被发现
+    graph.addEdge(last, 0);
+    TEST_CHECK(throws<std::invalid_argument>([&]() { graph.run(); }));
+
+    // 非法的边
+    TaskGraph small(pool);
+    size_t only = small.addNode([]() {});
+    TEST_CHECK(throws<std::invalid_argument>([&]() { small.addEdge(only, only); }));
+    TEST_CHECK(throws<std::invalid_argument>([&]() { small.addEdge(only, 5); }));
+
+    // 节点抛出异常：后继不再执行，run 重新抛出
+    {
+        std::atomic_bool after{false};
+        TaskGraph failing(pool);
+        size_t bad = failing.addNode([]() { throw std::runtime_error("node failed"); });
+        size_t next = failing.addNode([&]() { after = true; });
+        failing.addEdge(bad, next);
+        TEST_CHECK(throws<std::runtime_error>([&]() { failing.run(); }));
+        TEST_CHECK(!after.load());
+    }
+
+    // 空图直接返回
+    TaskGraph emptyGraph(pool);
+    emptyGraph.run();
+    TEST_CHECK(emptyGraph.size() == 0);
+
+    pool.stop();
+}
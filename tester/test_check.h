@@ -0,0 +1,32 @@
+//
+// Created by abstergo on 26-10-18.
+//
+
+#ifndef TBS_TESTER_TEST_CHECK_H
+#define TBS_TESTER_TEST_CHECK_H
+#include <iostream>
+
+/**
+ * @brief 失败的检查数，main 据此决定退出码
+ */
+inline int& testFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+/**
+ * @brief 检查条件，失败时输出位置与表达式并计数，不中断后续检查
+ */
+#define TEST_CHECK(cond)                                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(cond))                                                                                                   \
+        {                                                                                                              \
+            ++testFailures();                                                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond << std::endl;                         \
+        }                                                                                                              \
+    }                                                                                                                  \
+    while (0)
+
+#endif // TBS_TESTER_TEST_CHECK_H